@@ -0,0 +1,500 @@
+/*!
+    \file "benchmark.cpp"
+
+    Author: Matt Ervin <matt@impsoftware.org>
+    Formatting: 4 spaces/tab (spaces only; no tabs), 120 columns.
+    Doc-tool: Doxygen (http://www.doxygen.com/)
+
+    Heap benchmarks: times heapify, push, pop, update and heap sort of heap_t (with
+    each arity, sift and layout policy) and the other heaps against std::make_heap,
+    std::priority_queue and std::sort, over a sweep of sizes, item types and key
+    distributions.  Results are written to stdout as CSV (default) or JSON.
+
+    Usage: heap_benchmark [--json] [--min-size N] [--max-size N] [--header]
+        --json        Emit a JSON array instead of CSV rows.
+        --min-size N  Smallest size of the sweep (default 100.)
+        --max-size N  Largest size of the sweep (default 1000000; up to 100000000.)
+        --header      Emit the CSV header row (the 'benchmark' target in CMakeLists.txt passes it.)
+
+    Variants of the algorithms (recursive heapify up, the precise parent formula,
+    branchless child selection, prefetching) are policies, so they are all timed
+    side by side by one executable, as rows of their own "implementation".
+*/
+
+#include "heap.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <queue>
+#include <string>
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!\brief Benchmark item with a 64 bit key and a payload, 't_size' bytes in total.
+template <std::size_t t_size>
+struct item_t
+{
+    static_assert(sizeof(std::uint64_t) < t_size && 0 == t_size % sizeof(std::uint64_t), "Unsupported item size.");
+
+    std::uint64_t key = 0;
+    std::uint64_t payload[t_size / sizeof(std::uint64_t) - 1] = {};
+
+    friend bool operator<(item_t const& lhs, item_t const& rhs) { return lhs.key < rhs.key; }
+    friend bool operator>(item_t const& lhs, item_t const& rhs) { return lhs.key > rhs.key; }
+    friend bool operator==(item_t const& lhs, item_t const& rhs) { return lhs.key == rhs.key; }
+};
+
+template <typename t_item_t>
+struct item_traits_t;
+
+template <>
+struct item_traits_t<int>
+{
+    static constexpr char const* name = "int";
+    static int make(std::uint64_t const key) { return static_cast<int>(key & 0x7fffffff); }
+    static std::uint64_t key(int const item) { return static_cast<std::uint64_t>(item); }
+};
+
+template <std::size_t t_size>
+struct item_traits_t<item_t<t_size>>
+{
+    static constexpr char const* name = 16 == t_size ? "struct16" : "struct128";
+    static item_t<t_size> make(std::uint64_t const key)
+    {
+        auto item = item_t<t_size>{};
+        item.key = key;
+        item.payload[0] = key;
+        return item;
+    }
+    static std::uint64_t key(item_t<t_size> const& item) { return item.key; }
+};
+
+//!\brief Key distributions.
+enum class distribution_t
+{
+    random
+    , sorted
+    , reverse
+    , duplicates //!< Random keys drawn from only 16 distinct values.
+};
+
+static char const* name_of(distribution_t const distribution)
+{
+    switch (distribution)
+    {
+    case distribution_t::random: return "random";
+    case distribution_t::sorted: return "sorted";
+    case distribution_t::reverse: return "reverse";
+    case distribution_t::duplicates: return "duplicates";
+    }
+    return "unknown";
+}
+
+//!\brief Return 'size' keys (all below 2^31, so they also fit an int) with the given distribution.
+static std::vector<std::uint64_t> make_keys(std::size_t const size, distribution_t const distribution)
+{
+    std::vector<std::uint64_t> keys(size);
+    auto rng = std::mt19937_64{size};
+    for (std::size_t idx = 0; size > idx; ++idx)
+    {
+        switch (distribution)
+        {
+        case distribution_t::random: keys[idx] = rng() & 0x7fffffff; break;
+        case distribution_t::sorted: keys[idx] = idx; break;
+        case distribution_t::reverse: keys[idx] = size - idx; break;
+        case distribution_t::duplicates: keys[idx] = rng() % 16; break;
+        }
+    }
+    return keys;
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+struct result_t
+{
+    std::string implementation;
+    std::string operation;
+    char const* item_type;
+    char const* distribution;
+    std::size_t size;
+    double nanoseconds; //!< Best of the repetitions.
+};
+
+//!\brief Collects and prints results.
+class report_t
+{
+public:
+    explicit report_t(bool const json) : json_{json} {}
+
+    void add(result_t result) { results_.emplace_back(std::move(result)); }
+
+    void print_csv_header(std::ostream& os) const
+    {
+        os << "implementation,operation,item_type,distribution,size,nanoseconds,ns_per_item\n";
+    }
+
+    void print(std::ostream& os) const
+    {
+        if (json_)
+        {
+            os << "[\n";
+        }
+        for (std::size_t idx = 0; results_.size() > idx; ++idx)
+        {
+            auto const& result = results_[idx];
+            auto const ns_per_item = result.nanoseconds / static_cast<double>(std::max<std::size_t>(1, result.size));
+            if (json_)
+            {
+                os << "  {\"implementation\": \"" << result.implementation
+                   << "\", \"operation\": \"" << result.operation << "\", \"item_type\": \"" << result.item_type
+                   << "\", \"distribution\": \"" << result.distribution << "\", \"size\": " << result.size
+                   << ", \"nanoseconds\": " << result.nanoseconds << ", \"ns_per_item\": " << ns_per_item << '}'
+                   << (results_.size() - 1 == idx ? "\n" : ",\n");
+            }
+            else
+            {
+                os << result.implementation << ',' << result.operation << ',' << result.item_type << ','
+                   << result.distribution << ',' << result.size << ',' << result.nanoseconds << ','
+                   << ns_per_item << '\n';
+            }
+        }
+        if (json_)
+        {
+            os << "]\n";
+        }
+    }
+
+private:
+    bool json_;
+    std::vector<result_t> results_;
+};
+
+static std::uint64_t volatile sink = 0; //!< Keeps the compiler from discarding the benchmarked work.
+
+/*!
+    \brief Return the best time (in nanoseconds) of running 'run(state)' on a fresh 'prepare()' state.
+
+    Small sizes are repeated more often (about 10^5 items in total, but at most 100
+    times) so that their timings are not dominated by noise.
+*/
+template <typename t_prepare_t, typename t_run_t>
+double best_of(std::size_t const size, t_prepare_t const& prepare, t_run_t const& run)
+{
+    auto const repetitions = std::clamp<std::size_t>(100000 / std::max<std::size_t>(1, size), 1, 100);
+    auto best = std::numeric_limits<double>::max();
+    for (std::size_t repetition = 0; repetitions > repetition; ++repetition)
+    {
+        auto state = prepare();
+        auto const start = std::chrono::steady_clock::now();
+        run(state);
+        auto const stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count());
+    }
+    return best;
+}
+
+//!\brief Return ('size' / 8) (position, new key) pairs for the update benchmarks.
+static std::vector<std::pair<std::size_t, std::uint64_t>> make_updates(std::size_t const size)
+{
+    std::vector<std::pair<std::size_t, std::uint64_t>> updates(std::max<std::size_t>(1, size / 8));
+    auto rng = std::mt19937_64{size + 1};
+    for (auto& update : updates)
+    {
+        update = {static_cast<std::size_t>(rng() % size), rng() & 0x7fffffff};
+    }
+    return updates;
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!\brief Benchmark context: the items of one (item type, distribution, size) combination.
+template <typename t_item_t>
+struct context_t
+{
+    using item_type = t_item_t;
+    using traits_type = item_traits_t<item_type>;
+
+    report_t& report;
+    char const* distribution;
+    std::vector<item_type> items;
+    std::vector<std::pair<std::size_t, std::uint64_t>> updates;
+
+    [[nodiscard]] std::size_t size() const { return items.size(); }
+
+    template <typename t_prepare_t, typename t_run_t>
+    void time(std::string const& implementation, char const* operation, t_prepare_t const& prepare, t_run_t const& run)
+    {
+        report.add(result_t{
+            implementation
+            , operation
+            , traits_type::name
+            , distribution
+            , size()
+            , best_of(size(), prepare, run)
+        });
+    }
+};
+
+//!\brief Benchmark heap_t (as a max heap) with the given arity, sift and layout policies.
+template <std::size_t t_arity, typename t_sift_policy_t, typename t_layout_t, typename t_item_t>
+void bench_heap_t(context_t<t_item_t>& context, std::string const& name)
+{
+    using heap_type = max_heap_t<t_item_t, t_arity, t_sift_policy_t, t_layout_t>;
+    using iterator = typename std::vector<t_item_t>::iterator;
+    using heapify_type = typename heap_type::heapify_type;
+    using traits_type = item_traits_t<t_item_t>;
+
+    auto const copy_items = [&]{ return context.items; };
+    auto const make_heap = [&]{ return heap_type{context.items.begin(), context.items.end()}; };
+
+    context.time(name, "heapify", copy_items, [](std::vector<t_item_t>& items){
+        heapify_type{}(items.begin(), items.end());
+        sink = sink + traits_type::key(items.front());
+    });
+    context.time(name, "push", [&]{ auto heap = heap_type{}; heap.reserve(context.size()); return heap; },
+        [&](heap_type& heap){
+            for (auto const& item : context.items)
+            {
+                heap.push(item);
+            }
+            sink = sink + traits_type::key(heap.top());
+        });
+    context.time(name, "pop", make_heap, [](heap_type& heap){
+        while (!heap.empty())
+        {
+            sink = sink + traits_type::key(heap.top());
+            heap.pop();
+        }
+    });
+    context.time(name, "update", make_heap, [&](heap_type& heap){
+        for (auto const& [position, key] : context.updates)
+        {
+            heap.insert(heap.begin() + static_cast<std::ptrdiff_t>(position), traits_type::make(key));
+        }
+        sink = sink + traits_type::key(heap.top());
+    });
+    context.time(name, "heap_sort", copy_items, [](std::vector<t_item_t>& items){
+        heap_sort_t<iterator, heapify_type>{}(items.begin(), items.end());
+        sink = sink + traits_type::key(items.front());
+    });
+}
+
+//!\brief Benchmark the standard library baselines.
+template <typename t_item_t>
+void bench_std(context_t<t_item_t>& context)
+{
+    using queue_type = std::priority_queue<t_item_t>;
+    using traits_type = item_traits_t<t_item_t>;
+
+    auto const copy_items = [&]{ return context.items; };
+
+    context.time("std::make_heap", "heapify", copy_items, [](std::vector<t_item_t>& items){
+        std::make_heap(items.begin(), items.end());
+        sink = sink + traits_type::key(items.front());
+    });
+    context.time("std::priority_queue", "push", [&]{
+        auto storage = std::vector<t_item_t>{};
+        storage.reserve(context.size());
+        return queue_type{std::less<t_item_t>{}, std::move(storage)};
+    }, [&](queue_type& queue){
+        for (auto const& item : context.items)
+        {
+            queue.push(item);
+        }
+        sink = sink + traits_type::key(queue.top());
+    });
+    context.time("std::priority_queue", "pop", [&]{ return queue_type{context.items.begin(), context.items.end()}; },
+        [](queue_type& queue){
+            while (!queue.empty())
+            {
+                sink = sink + traits_type::key(queue.top());
+                queue.pop();
+            }
+        });
+    context.time("std::make_heap+sort_heap", "heap_sort", copy_items, [](std::vector<t_item_t>& items){
+        std::make_heap(items.begin(), items.end());
+        std::sort_heap(items.begin(), items.end());
+        sink = sink + traits_type::key(items.front());
+    });
+    context.time("std::sort", "heap_sort", copy_items, [](std::vector<t_item_t>& items){
+        std::sort(items.begin(), items.end());
+        sink = sink + traits_type::key(items.front());
+    });
+}
+
+//!\brief Benchmark the node based and the specialized heaps.
+template <typename t_item_t>
+void bench_other_heaps(context_t<t_item_t>& context)
+{
+    using pairing_heap_type = max_pairing_heap_t<t_item_t>;
+    using radix_heap_type = radix_heap_t<std::uint64_t, t_item_t>;
+    using traits_type = item_traits_t<t_item_t>;
+
+    context.time("pairing_heap_t", "push", []{ return pairing_heap_type{}; }, [&](pairing_heap_type& heap){
+        for (auto const& item : context.items)
+        {
+            heap.push(item);
+        }
+        sink = sink + traits_type::key(heap.top());
+    });
+
+    auto const make_pairing_heap = [&]{
+        auto state = std::make_pair(pairing_heap_type{}, std::vector<typename pairing_heap_type::handle_type>{});
+        state.second.reserve(context.size());
+        for (auto const& item : context.items)
+        {
+            state.second.emplace_back(state.first.push(item));
+        }
+        return state;
+    };
+    using pairing_state_type = decltype(make_pairing_heap());
+    context.time("pairing_heap_t", "pop", make_pairing_heap, [](pairing_state_type& state){
+        while (!state.first.empty())
+        {
+            sink = sink + traits_type::key(state.first.top());
+            state.first.pop();
+        }
+    });
+    context.time("pairing_heap_t", "update", make_pairing_heap, [&](pairing_state_type& state){
+        for (auto const& [position, key] : context.updates)
+        {
+            state.first.update(state.second[position], traits_type::make(key));
+        }
+        sink = sink + traits_type::key(state.first.top());
+    });
+
+    // The radix heap is a min heap for monotone workloads: push everything, then pop everything.
+    auto const make_radix_heap = [&]{
+        auto heap = radix_heap_type{};
+        for (auto const& item : context.items)
+        {
+            heap.push(traits_type::key(item), item);
+        }
+        return heap;
+    };
+    context.time("radix_heap_t", "push", []{ return radix_heap_type{}; }, [&](radix_heap_type& heap){
+        for (auto const& item : context.items)
+        {
+            heap.push(traits_type::key(item), item);
+        }
+        sink = sink + heap.size();
+    });
+    context.time("radix_heap_t", "pop", make_radix_heap, [](radix_heap_type& heap){
+        while (!heap.empty())
+        {
+            sink = sink + heap.pop_value().first;
+        }
+    });
+}
+
+//!\brief Benchmark heap_t's parallel heapify.
+template <typename t_item_t>
+void bench_parallel(context_t<t_item_t>& context)
+{
+    using heapify_type = typename max_heap_t<t_item_t>::heapify_type;
+    using traits_type = item_traits_t<t_item_t>;
+
+    context.time("heap_t<2>+parallel", "heapify", [&]{ return context.items; }, [](std::vector<t_item_t>& items){
+        heapify_type{}(items.begin(), items.end(), parallel_policy_t{});
+        sink = sink + traits_type::key(items.front());
+    });
+}
+
+template <typename t_item_t>
+void bench_all(report_t& report, std::size_t const size, distribution_t const distribution)
+{
+    using traits_type = item_traits_t<t_item_t>;
+
+    auto const keys = make_keys(size, distribution);
+    auto context = context_t<t_item_t>{report, name_of(distribution), {}, make_updates(size)};
+    context.items.reserve(size);
+    for (auto const key : keys)
+    {
+        context.items.emplace_back(traits_type::make(key));
+    }
+
+    bench_heap_t<2, top_down_sift_t, flat_layout_t<2>>(context, "heap_t<2>");
+    bench_heap_t<4, top_down_sift_t, flat_layout_t<4>>(context, "heap_t<4>");
+    bench_heap_t<8, top_down_sift_t, flat_layout_t<8>>(context, "heap_t<8>");
+    bench_heap_t<2, bottom_up_sift_t, flat_layout_t<2>>(context, "heap_t<2>+bottom_up");
+    bench_heap_t<4, bottom_up_sift_t, flat_layout_t<4>>(context, "heap_t<4>+bottom_up");
+    // Prefetching at every size (the default threshold only enables it for heaps larger than the caches.)
+    bench_heap_t<2, prefetch_sift_t<top_down_sift_t, 0>, flat_layout_t<2>>(context, "heap_t<2>+prefetch");
+    bench_heap_t<4, prefetch_sift_t<top_down_sift_t, 0>, flat_layout_t<4>>(context, "heap_t<4>+prefetch");
+    bench_heap_t<4, prefetch_sift_t<bottom_up_sift_t, 0>, flat_layout_t<4>>(context, "heap_t<4>+bottom_up+prefetch");
+    bench_heap_t<2, recursive_sift_up_t<>, flat_layout_t<2>>(context, "heap_t<2>+recursive_up");
+    bench_heap_t<2, top_down_sift_t, precise_flat_layout_t<2>>(context, "heap_t<2>+precise_parent");
+    bench_heap_t<2, branchless_sift_t<>, flat_layout_t<2>>(context, "heap_t<2>+branchless");
+    bench_heap_t<4, branchless_sift_t<>, flat_layout_t<4>>(context, "heap_t<4>+branchless");
+    bench_heap_t<2, branchless_sift_t<bottom_up_sift_t>, flat_layout_t<2>>(context, "heap_t<2>+bottom_up+branchless");
+    bench_heap_t<2, top_down_sift_t, blocked_layout_t<2, 3>>(context, "heap_t<2>+blocked<3>");
+    bench_heap_t<4, top_down_sift_t, page_blocked_layout_t<t_item_t, 4>>(context, "heap_t<4>+page_blocked");
+    bench_parallel(context);
+    bench_other_heaps(context);
+    bench_std(context);
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+int main(int argc, char** argv)
+{
+    auto json = false;
+    auto header = false;
+    std::size_t min_size = 100;
+    std::size_t max_size = 1000000;
+    for (int arg = 1; argc > arg; ++arg)
+    {
+        if (0 == std::strcmp("--json", argv[arg]))
+        {
+            json = true;
+        }
+        else if (0 == std::strcmp("--header", argv[arg]))
+        {
+            header = true;
+        }
+        else if (0 == std::strcmp("--min-size", argv[arg]) && argc > arg + 1)
+        {
+            min_size = std::strtoull(argv[++arg], nullptr, 10);
+        }
+        else if (0 == std::strcmp("--max-size", argv[arg]) && argc > arg + 1)
+        {
+            max_size = std::strtoull(argv[++arg], nullptr, 10);
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--json] [--min-size N] [--max-size N] [--header]\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    auto report = report_t{json};
+    for (auto size = std::max<std::size_t>(1, min_size); max_size >= size; size *= 10)
+    {
+        for (auto const distribution : {
+            distribution_t::random
+            , distribution_t::sorted
+            , distribution_t::reverse
+            , distribution_t::duplicates
+        })
+        {
+            std::cerr << "size " << size << ", " << name_of(distribution) << " keys\n";
+            bench_all<int>(report, size, distribution);
+            bench_all<item_t<16>>(report, size, distribution);
+            bench_all<item_t<128>>(report, size, distribution);
+        }
+    }
+
+    if (header && !json)
+    {
+        report.print_csv_header(std::cout);
+    }
+    report.print(std::cout);
+    std::cout << std::flush;
+    return 0 == sink + 1 ? EXIT_FAILURE : EXIT_SUCCESS; // (Never fails; reads the sink.)
+}
+
+/*
+    End of "benchmark.cpp"
+*/
@@ -0,0 +1,5336 @@
+/*!
+    \file "heap.h"
+
+    Author: Matt Ervin <matt@impsoftware.org>
+    Formatting: 4 spaces/tab (spaces only; no tabs), 120 columns.
+    Doc-tool: Doxygen (http://www.doxygen.com/)
+
+    Experimental C++ heap implementation (for learning and practice).
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE4_1__) || defined(__AVX__)
+#include <immintrin.h>
+#endif // #if defined(__SSE4_1__) || defined(__AVX__)
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif // #if defined(__aarch64__) && defined(__ARM_NEON)
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // #if defined(__unix__) || defined(__APPLE__)
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#endif // #if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+/*
+    left_child_idx = 2 * left_parent_idx + 1
+    right_child_idx = 2 * right_parent_idx + 2
+    left_parent_idx = (left_child_idx - 1) / 2
+    right_parent_idx = (right_child_idx - 2) / 2
+    Rule: left node indexes are always odd,
+          right node indexes are always even.
+
+    Generalized to a d-ary heap (d = t_arity):
+    first_child_idx = d * parent_idx + 1
+    last_child_idx = d * parent_idx + d
+    parent_idx = (child_idx - 1) / d
+    A larger arity makes the tree shallower (log_d(n) levels) and keeps
+    all siblings adjacent in memory, at the cost of d - 1 comparisons
+    per level when heapifying down.
+
+    The iterative implementations sift a "hole" instead of swapping:
+    the moving value is lifted out once, parents (or children) are moved
+    into the hole one level at a time, and the value is written once at
+    its final position, i.e. one move per level instead of the three
+    moves of a swap.
+
+    Every time a value is stored at a position, the slot observer is
+    called with (begin, position) so that containers can track where
+    their items are (e.g. an addressable heap's handle -> position map.)
+
+    Where a node's parent and children are stored is decided by the layout
+    policy.  Every layout keeps siblings adjacent (children of 'idx' are
+    [first_child(idx), first_child(idx) + d)) and stores a parent before
+    its children, so the items of a heap of size n always occupy [0, n).
+*/
+
+/*!
+    \brief Layout policy: the classic flat (breadth first) layout, i.e. the formulas above.
+
+    With 't_precise_parent', parent() subtracts each child's exact offset from its
+    parent's first child (the right_parent_idx formula above) instead of 1 before
+    dividing; the result is the same, this only exists to benchmark the two.
+*/
+template <std::size_t t_arity = 2, bool t_precise_parent = false>
+struct flat_layout_t
+{
+    static constexpr std::size_t arity = t_arity;
+    static constexpr bool is_precise_parent = t_precise_parent;
+
+    //!\brief Return the index of the parent of 'node_idx' (negative for the root when precise.)
+    template <typename t_idx_t>
+    [[nodiscard]] static constexpr t_idx_t parent(t_idx_t const node_idx)
+    {
+        constexpr auto d = static_cast<t_idx_t>(arity);
+        t_idx_t child_offset = 1;
+        if constexpr (is_precise_parent)
+        {
+            if constexpr (2 == arity)
+            {
+                child_offset = (1 << (~node_idx & 0x1)) & 0x3;
+            }
+            else
+            {
+                child_offset = 1 + (node_idx + d - 1) % d;
+            }
+        }
+        return (node_idx - child_offset) / d;
+    }
+
+    template <typename t_idx_t>
+    [[nodiscard]] static constexpr t_idx_t first_child(t_idx_t const node_idx)
+    {
+        return node_idx * static_cast<t_idx_t>(arity) + 1;
+    }
+
+    //!\brief Return the index of the last node (of a heap of 'size' > 1 items) that has a child.
+    template <typename t_idx_t>
+    [[nodiscard]] static constexpr t_idx_t last_parent(t_idx_t const size)
+    {
+        return parent(size - 1);
+    }
+};
+
+//!\brief Flat layout whose parent() uses the precise child offset (see flat_layout_t.)
+template <std::size_t t_arity = 2>
+using precise_flat_layout_t = flat_layout_t<t_arity, true>;
+
+//!\brief True if 't_layout_t' is (a variant of) the flat layout, whose levels are contiguous index ranges.
+template <typename t_layout_t>
+inline constexpr bool is_flat_layout_v = false;
+
+template <std::size_t t_arity, bool t_precise_parent>
+inline constexpr bool is_flat_layout_v<flat_layout_t<t_arity, t_precise_parent>> = true;
+
+/*!
+    \brief Layout policy: cache/page blocked "B-heap" layout.
+
+    In the flat layout every level of a large heap is a cache (and TLB) miss,
+    because the children of 'idx' are ~d*idx away.  This layout stores the tree
+    in blocks: a block holds a group of siblings and all of their descendants
+    t_block_height - 1 levels down, i.e. B = d + d^2 + ... + d^h nodes, and
+    each of the d^h nodes on a block's bottom level has its children (again a
+    group of siblings) at the start of another block.  So a heapify step
+    crosses into another block only once every h levels.
+
+    Slot 0 is the root, block k occupies slots [1 + k*B, 1 + (k + 1)*B), and
+    block k's child blocks are k*d^h + 1 ... k*d^h + d^h (the blocks form a
+    d^h-ary tree, laid out flat.)  Within a block, node offset 'o' has its
+    children at offset d*(o + 1).  The layout is filled in slot order, so the
+    heap is still stored densely in [0, n); a partially filled block merely
+    makes the tree at most h levels deeper than a flat one.
+    With t_block_height = 1 this is exactly the flat layout.
+*/
+template <std::size_t t_arity = 2, std::size_t t_block_height = 3>
+struct blocked_layout_t
+{
+    static_assert(1 <= t_block_height, "A block must hold at least one level.");
+
+    static constexpr std::size_t arity = t_arity;
+    static constexpr std::size_t block_height = t_block_height;
+
+    //!\brief Number of nodes on a block's bottom level (= number of child blocks of a block.)
+    static constexpr std::size_t block_leaf_count = []{
+        std::size_t count = 1;
+        for (std::size_t level = 0; block_height > level; ++level)
+        {
+            count *= arity;
+        }
+        return count;
+    }();
+
+    //!\brief Number of nodes in a block.
+    static constexpr std::size_t block_size = arity * (block_leaf_count - 1) / (arity - 1);
+
+    template <typename t_idx_t>
+    [[nodiscard]] static constexpr t_idx_t parent(t_idx_t const node_idx)
+    {
+        constexpr auto d = static_cast<t_idx_t>(arity);
+        constexpr auto b = static_cast<t_idx_t>(block_size);
+        constexpr auto leaf_count = static_cast<t_idx_t>(block_leaf_count);
+
+        auto const block = (node_idx - 1) / b;
+        auto const offset = (node_idx - 1) % b;
+        if (d <= offset)
+        {
+            return 1 + block * b + offset / d - 1; // Same block.
+        }
+        else if (0 == block)
+        {
+            return 0; // The root.
+        }
+
+        // Top level of a block: the parent is on the parent block's bottom level.
+        auto const parent_block = (block - 1) / leaf_count;
+        auto const leaf = (block - 1) % leaf_count;
+        return 1 + parent_block * b + (b - leaf_count) + leaf;
+    }
+
+    template <typename t_idx_t>
+    [[nodiscard]] static constexpr t_idx_t first_child(t_idx_t const node_idx)
+    {
+        constexpr auto d = static_cast<t_idx_t>(arity);
+        constexpr auto b = static_cast<t_idx_t>(block_size);
+        constexpr auto leaf_count = static_cast<t_idx_t>(block_leaf_count);
+
+        if (0 == node_idx)
+        {
+            return 1;
+        }
+
+        auto const block = (node_idx - 1) / b;
+        auto const offset = (node_idx - 1) % b;
+        auto const child_offset = d * (offset + 1);
+        if (b > child_offset)
+        {
+            return 1 + block * b + child_offset; // Same block.
+        }
+
+        // Bottom level of a block: the children are the top level of a child block.
+        auto const leaf = offset - (b - leaf_count);
+        return 1 + (block * leaf_count + 1 + leaf) * b;
+    }
+
+    //!\brief Return an index at or after the last node that has a child (parents are not monotonic here.)
+    template <typename t_idx_t>
+    [[nodiscard]] static constexpr t_idx_t last_parent(t_idx_t const size)
+    {
+        return size - 1;
+    }
+};
+
+//!\brief Blocked layout with the tallest blocks of 't_item_t' that fit in a 't_block_bytes' (e.g. VM) page.
+template <typename t_item_t, std::size_t t_arity = 2, std::size_t t_block_bytes = 4096>
+struct page_blocked_layout
+{
+    static constexpr std::size_t block_height = []{
+        std::size_t height = 1;
+        std::size_t leaf_count = t_arity;
+        std::size_t size = t_arity;
+        while ((size + leaf_count * t_arity) * sizeof(t_item_t) <= t_block_bytes)
+        {
+            leaf_count *= t_arity;
+            size += leaf_count;
+            ++height;
+        }
+        return height;
+    }();
+
+    using type = blocked_layout_t<t_arity, block_height>;
+};
+
+template <typename t_item_t, std::size_t t_arity = 2, std::size_t t_block_bytes = 4096>
+using page_blocked_layout_t = typename page_blocked_layout<t_item_t, t_arity, t_block_bytes>::type;
+
+//!\brief Slot observer that does nothing (the default; compiles away.)
+struct null_slot_observer_t
+{
+    template <typename t_iter_t>
+    constexpr void operator()(t_iter_t const&, t_iter_t const&) const
+    {
+        // Do nothing.
+    }
+};
+
+//!\brief Counters collected by counting_stats_t.
+struct heap_stats_t
+{
+    static constexpr std::size_t max_sift_depth = 63; //!< Deeper sifts are counted in the last histogram bucket.
+
+    std::size_t comparisons = 0; //!< Comparator calls (or the equivalent comparisons of a SIMD child selection.)
+    std::size_t moves = 0; //!< Item moves (a swap counts as three.)
+    std::size_t sifts = 0; //!< Heapify up/down calls.
+    std::size_t levels = 0; //!< Levels traversed by all sifts.
+    std::array<std::size_t, max_sift_depth + 1> sift_depths{}; //!< Histogram: sifts by the levels they traversed.
+};
+
+/*!
+    \brief Stats policy that collects nothing (the default; compiles away.)
+
+    The heapify kernels report every comparison, move and (at the end of each heapify
+    up/down call) the number of levels traversed to their stats policy; containers
+    report every change to the whole heap to 'check()', e.g. to verify the heap order.
+*/
+struct null_stats_t
+{
+    static constexpr bool is_enabled = false;
+
+    constexpr void compare(std::size_t /*count*/ = 1) const {}
+    constexpr void move(std::size_t /*count*/ = 1) const {}
+    constexpr void sift(std::size_t /*levels*/) const {}
+
+    template <typename t_iter_t, typename t_cmp_op_t, typename t_layout_t>
+    constexpr void check(t_iter_t const&, t_iter_t const&, t_cmp_op_t const&, t_layout_t const&) const {}
+};
+
+//!\brief Return the first item in [begin, end) that belongs above its parent (end if the range is a valid heap.)
+template <typename t_layout_t, typename t_cmp_op_t, typename t_iter_t>
+[[nodiscard]] constexpr t_iter_t find_heap_violation(t_iter_t const begin, t_iter_t const end)
+{
+    for (auto node = begin + 1; end > node; ++node)
+    {
+        if (t_cmp_op_t{}(*node, *(begin + t_layout_t::parent(node - begin))))
+        {
+            return node;
+        }
+    }
+    return end;
+}
+
+/*!
+    \brief Stats policy that counts into a heap_stats_t (which it points to and does not own.)
+
+    With 't_check_invariant', check() also asserts (in debug builds) that the heap order holds.
+*/
+template <bool t_check_invariant = false>
+struct counting_stats_t
+{
+    static constexpr bool is_enabled = true;
+    static constexpr bool checks_invariant = t_check_invariant;
+
+    heap_stats_t* counters = nullptr;
+
+    constexpr void compare(std::size_t const count = 1) const { counters->comparisons += count; }
+    constexpr void move(std::size_t const count = 1) const { counters->moves += count; }
+
+    constexpr void sift(std::size_t const levels) const
+    {
+        ++counters->sifts;
+        counters->levels += levels;
+        ++counters->sift_depths[std::min(levels, heap_stats_t::max_sift_depth)];
+    }
+
+    template <typename t_iter_t, typename t_cmp_op_t, typename t_layout_t>
+    void check(t_iter_t const& begin, t_iter_t const& end, t_cmp_op_t const&, t_layout_t const&) const
+    {
+        if constexpr (checks_invariant)
+        {
+            assert(end == (find_heap_violation<t_layout_t, t_cmp_op_t>(begin, end)) && "Heap order violated");
+        }
+        static_cast<void>(begin);
+        static_cast<void>(end);
+    }
+};
+
+//!\brief Heapify down policy: compare the value against the best child at every level (sift down from the top.)
+struct top_down_sift_t {};
+
+/*!
+    \brief Heapify down policy: walk the best-child path all the way down to a leaf, then heapify the value back up.
+
+    Floyd/Wegener "bottom-up" heapify: only d - 1 comparisons per level (to select
+    the best child) are needed on the way down, plus a few comparisons on the way
+    back up.  The value heapified down by pop() and heap sort is the former last
+    leaf, which almost always belongs near the bottom again, so this saves close
+    to half of the comparisons of a binary heap when comparisons are expensive.
+*/
+struct bottom_up_sift_t {};
+
+/*!
+    \brief Heapify down policy: 't_sift_policy_t', prefetching the nodes that the next levels will
+           select from, in heaps of at least 't_min_heap_bytes' (smaller heaps stay in the caches.)
+
+    Each level of a sift down of a heap much larger than the last level cache stalls
+    on loading the children.  The descendants of the children one level down (two for
+    a binary heap, whose grandchildren are only 4 items) are a contiguous block in the
+    flat layout (and within a block of a blocked layout), so their cache lines are
+    requested before comparing the children and arrive while the sift works its way
+    down to them.  Only contiguous iterators (pointers, std::vector) are prefetched.
+*/
+template <typename t_sift_policy_t = top_down_sift_t, std::size_t t_min_heap_bytes = std::size_t{8} << 20>
+struct prefetch_sift_t {};
+
+/*!
+    \brief Heapify down policy: 't_sift_policy_t', selecting the best child with conditional
+           moves instead of a branch per sibling.
+
+    With random keys, which sibling is best is a coin toss, so a branch on it is
+    mispredicted about half of the time; computing the best index arithmetically
+    trades that for a data dependency.  (The SIMD kernels are branchless anyway.)
+*/
+template <typename t_sift_policy_t = top_down_sift_t>
+struct branchless_sift_t {};
+
+/*!
+    \brief Heapify up policy: 't_sift_policy_t' (for heapifying down), but heapify up by
+           recursively swapping a node with its parent instead of moving a hole.
+
+    Space complexity O(log(n)) (the call stack) instead of O(1), and three moves per
+    level instead of one; this only exists to benchmark the two.
+*/
+template <typename t_sift_policy_t = top_down_sift_t>
+struct recursive_sift_up_t {};
+
+/*!
+    \brief What a (possibly wrapped) sift policy asks of heapify_up_t and heapify_down_t.
+
+    'base_type' is the innermost policy (top_down_sift_t or bottom_up_sift_t); each
+    wrapper (prefetch_sift_t, branchless_sift_t, recursive_sift_up_t) sets its own
+    option on top of those of the policy it wraps, so wrappers compose, e.g.
+    prefetch_sift_t<branchless_sift_t<bottom_up_sift_t>>.
+*/
+template <typename t_sift_policy_t>
+struct sift_policy_traits
+{
+    using base_type = t_sift_policy_t;
+    static constexpr bool is_prefetching = false;
+    static constexpr std::size_t min_prefetch_heap_bytes = std::numeric_limits<std::size_t>::max();
+    static constexpr bool is_branchless = false;
+    static constexpr bool is_recursive_up = false;
+};
+
+template <typename t_sift_policy_t, std::size_t t_min_heap_bytes>
+struct sift_policy_traits<prefetch_sift_t<t_sift_policy_t, t_min_heap_bytes>> : sift_policy_traits<t_sift_policy_t>
+{
+    static constexpr bool is_prefetching = true;
+    static constexpr std::size_t min_prefetch_heap_bytes = t_min_heap_bytes;
+};
+
+template <typename t_sift_policy_t>
+struct sift_policy_traits<branchless_sift_t<t_sift_policy_t>> : sift_policy_traits<t_sift_policy_t>
+{
+    static constexpr bool is_branchless = true;
+};
+
+template <typename t_sift_policy_t>
+struct sift_policy_traits<recursive_sift_up_t<t_sift_policy_t>> : sift_policy_traits<t_sift_policy_t>
+{
+    static constexpr bool is_recursive_up = true;
+};
+
+//!\brief Hint the CPU to load the cache line at 'address' for reading (no-op where unsupported.)
+inline void prefetch_for_read(void const* const address)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 3);
+#else // #if defined(__GNUC__) || defined(__clang__)
+    static_cast<void>(address);
+#endif // #if defined(__GNUC__) || defined(__clang__)
+}
+
+template <
+    typename t_iter_t
+    , typename t_cmp_op_t = std::greater<
+        typename std::iterator_traits<t_iter_t>::value_type
+    >
+    , std::size_t t_arity = 2
+    , typename t_layout_t = flat_layout_t<t_arity>
+    , typename t_slot_observer_t = null_slot_observer_t
+    , typename t_stats_t = null_stats_t
+    , typename t_sift_policy_t = top_down_sift_t
+>
+struct heapify_up_t
+{
+    static_assert(2 <= t_arity, "A heap node must be able to have at least two children.");
+    static_assert(t_layout_t::arity == t_arity, "The layout must be for the same arity.");
+
+    using iter_type = t_iter_t;
+    using cmp_op_type = t_cmp_op_t;
+    using difference_type = typename std::iterator_traits<iter_type>::difference_type;
+    using value_type = typename std::iterator_traits<iter_type>::value_type;
+    using layout_type = t_layout_t;
+    using slot_observer_type = t_slot_observer_t;
+    using stats_type = t_stats_t;
+    using sift_policy_type = t_sift_policy_t;
+
+    static constexpr std::size_t arity = t_arity;
+    static constexpr bool is_recursive = sift_policy_traits<sift_policy_type>::is_recursive_up;
+
+    slot_observer_type observer;
+    stats_type stats = {};
+
+    constexpr void operator()(iter_type begin, iter_type node)
+    {
+        if constexpr (is_recursive)
+        {
+            // Recursive implementation: space complexity = O(lg(n))
+            //                           time complexity = O(lg(n))
+            if (begin < node)
+            {
+                auto parent = begin + layout_type::parent(node - begin);
+                stats.compare();
+                if (cmp_op_type{}(*node, *parent))
+                {
+                    std::swap(*parent, *node);
+                    stats.move(3);
+                    stats.sift(1);
+                    observer(begin, node);
+                    observer(begin, parent);
+                    heapify_up_t{observer, stats}(std::move(begin), std::move(parent));
+                }
+            }
+        }
+        else
+        {
+            // Iterative implementation: space complexity = O(1)
+            //                           time complexity = O(lg(n))
+            auto value = std::move(*node);
+            stats.move();
+            (*this)(std::move(begin), std::move(node), std::move(value));
+        }
+    }
+
+    //!\brief Heapify 'value' up from the vacant position 'hole' and store it at its final position.
+    constexpr void operator()(iter_type begin, iter_type hole, value_type&& value)
+    {
+        std::size_t levels = 0;
+        while (begin < hole)
+        {
+            auto parent = begin + layout_type::parent(hole - begin);
+            stats.compare();
+            if (!cmp_op_type{}(value, *parent))
+            {
+                break;
+            }
+
+            *hole = std::move(*parent);
+            stats.move();
+            observer(begin, hole);
+            hole = parent;
+            ++levels;
+        }
+
+        *hole = std::move(value);
+        stats.move();
+        stats.sift(levels);
+        observer(begin, hole);
+    }
+};
+
+/*!
+    \brief SIMD kernel that returns the index of the extreme (minimum when 't_select_min',
+           otherwise maximum) of 't_arity' contiguous keys, the leftmost one on ties.
+
+    The primary template is disabled.  Specializations exist for the key type and
+    arity combinations that the target instruction set supports (enable them with
+    e.g. -msse4.1, -mavx2 or -march=native):
+        SSE4.1:   4 x int32/uint32/float
+        AVX:      8 x float, 4 x double, 8 x double
+        AVX2:     8 x int32/uint32, 4 x int64/uint64, 8 x int64/uint64
+        AArch64:  4 x int32/uint32/float, 8 x int32/uint32/float (NEON)
+
+    NaN keys have no order, so (as with the scalar scan) which of them is selected is
+    unspecified, but the index is always one of the 't_arity' keys.
+*/
+template <typename t_key_t, bool t_select_min, std::size_t t_arity>
+struct simd_extreme_t
+{
+    static constexpr bool is_enabled = false;
+};
+
+#if defined(__SSE4_1__) || defined(__AVX__) || (defined(__aarch64__) && defined(__ARM_NEON))
+//!\brief Return the lowest lane set in a kernel's 'mask' of lanes equal to the extreme, or 0 if none is (NaN keys.)
+inline std::size_t first_lane_of(unsigned const mask)
+{
+    return 0 == mask ? 0 : static_cast<std::size_t>(__builtin_ctz(mask));
+}
+#endif // #if defined(__SSE4_1__) || defined(__AVX__) || (defined(__aarch64__) && defined(__ARM_NEON))
+
+#if defined(__SSE4_1__)
+template <bool t_select_min>
+struct simd_extreme_t<std::int32_t, t_select_min, 4>
+{
+    static constexpr bool is_enabled = true;
+
+    static __m128i extreme(__m128i const lhs, __m128i const rhs)
+    {
+        if constexpr (t_select_min) { return _mm_min_epi32(lhs, rhs); } else { return _mm_max_epi32(lhs, rhs); }
+    }
+
+    static std::size_t index_of(std::int32_t const* keys)
+    {
+        auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(keys));
+        auto m = extreme(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+        m = extreme(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+        auto const mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, m)));
+        return first_lane_of(static_cast<unsigned>(mask));
+    }
+};
+
+template <bool t_select_min>
+struct simd_extreme_t<std::uint32_t, t_select_min, 4>
+{
+    static constexpr bool is_enabled = true;
+
+    static __m128i extreme(__m128i const lhs, __m128i const rhs)
+    {
+        if constexpr (t_select_min) { return _mm_min_epu32(lhs, rhs); } else { return _mm_max_epu32(lhs, rhs); }
+    }
+
+    static std::size_t index_of(std::uint32_t const* keys)
+    {
+        auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(keys));
+        auto m = extreme(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+        m = extreme(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+        auto const mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, m)));
+        return first_lane_of(static_cast<unsigned>(mask));
+    }
+};
+
+template <bool t_select_min>
+struct simd_extreme_t<float, t_select_min, 4>
+{
+    static constexpr bool is_enabled = true;
+
+    static __m128 extreme(__m128 const lhs, __m128 const rhs)
+    {
+        if constexpr (t_select_min) { return _mm_min_ps(lhs, rhs); } else { return _mm_max_ps(lhs, rhs); }
+    }
+
+    static std::size_t index_of(float const* keys)
+    {
+        auto const v = _mm_loadu_ps(keys);
+        auto m = extreme(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+        m = extreme(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+        auto const mask = _mm_movemask_ps(_mm_cmpeq_ps(v, m));
+        return first_lane_of(static_cast<unsigned>(mask));
+    }
+};
+#endif // #if defined(__SSE4_1__)
+
+#if defined(__AVX__)
+template <bool t_select_min>
+struct simd_extreme_t<float, t_select_min, 8>
+{
+    static constexpr bool is_enabled = true;
+
+    static __m256 extreme(__m256 const lhs, __m256 const rhs)
+    {
+        if constexpr (t_select_min) { return _mm256_min_ps(lhs, rhs); } else { return _mm256_max_ps(lhs, rhs); }
+    }
+
+    static std::size_t index_of(float const* keys)
+    {
+        auto const v = _mm256_loadu_ps(keys);
+        auto m = extreme(v, _mm256_permute2f128_ps(v, v, 1));
+        m = extreme(m, _mm256_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+        m = extreme(m, _mm256_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+        auto const mask = _mm256_movemask_ps(_mm256_cmp_ps(v, m, _CMP_EQ_OQ));
+        return first_lane_of(static_cast<unsigned>(mask));
+    }
+};
+
+template <bool t_select_min>
+struct simd_extreme_t<double, t_select_min, 4>
+{
+    static constexpr bool is_enabled = true;
+
+    static __m256d extreme(__m256d const lhs, __m256d const rhs)
+    {
+        if constexpr (t_select_min) { return _mm256_min_pd(lhs, rhs); } else { return _mm256_max_pd(lhs, rhs); }
+    }
+
+    //!\brief Return 'v' with its extreme broadcast to all lanes.
+    static __m256d reduce(__m256d const v)
+    {
+        auto const m = extreme(v, _mm256_permute2f128_pd(v, v, 1));
+        return extreme(m, _mm256_shuffle_pd(m, m, 0x5));
+    }
+
+    static std::size_t index_of(double const* keys)
+    {
+        auto const v = _mm256_loadu_pd(keys);
+        auto const mask = _mm256_movemask_pd(_mm256_cmp_pd(v, reduce(v), _CMP_EQ_OQ));
+        return first_lane_of(static_cast<unsigned>(mask));
+    }
+};
+
+template <bool t_select_min>
+struct simd_extreme_t<double, t_select_min, 8>
+{
+    static constexpr bool is_enabled = true;
+
+    using half_type = simd_extreme_t<double, t_select_min, 4>;
+
+    static std::size_t index_of(double const* keys)
+    {
+        auto const lo = _mm256_loadu_pd(keys);
+        auto const hi = _mm256_loadu_pd(keys + 4);
+        auto const m = half_type::reduce(half_type::extreme(lo, hi));
+        auto const mask = _mm256_movemask_pd(_mm256_cmp_pd(lo, m, _CMP_EQ_OQ))
+            | (_mm256_movemask_pd(_mm256_cmp_pd(hi, m, _CMP_EQ_OQ)) << 4);
+        return first_lane_of(static_cast<unsigned>(mask));
+    }
+};
+#endif // #if defined(__AVX__)
+
+#if defined(__AVX2__)
+template <bool t_select_min>
+struct simd_extreme_t<std::int32_t, t_select_min, 8>
+{
+    static constexpr bool is_enabled = true;
+
+    static __m256i extreme(__m256i const lhs, __m256i const rhs)
+    {
+        if constexpr (t_select_min) { return _mm256_min_epi32(lhs, rhs); } else { return _mm256_max_epi32(lhs, rhs); }
+    }
+
+    static std::size_t index_of(std::int32_t const* keys)
+    {
+        auto const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(keys));
+        auto m = extreme(v, _mm256_permute2x128_si256(v, v, 1));
+        m = extreme(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+        m = extreme(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+        auto const mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, m)));
+        return first_lane_of(static_cast<unsigned>(mask));
+    }
+};
+
+template <bool t_select_min>
+struct simd_extreme_t<std::uint32_t, t_select_min, 8>
+{
+    static constexpr bool is_enabled = true;
+
+    static __m256i extreme(__m256i const lhs, __m256i const rhs)
+    {
+        if constexpr (t_select_min) { return _mm256_min_epu32(lhs, rhs); } else { return _mm256_max_epu32(lhs, rhs); }
+    }
+
+    static std::size_t index_of(std::uint32_t const* keys)
+    {
+        auto const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(keys));
+        auto m = extreme(v, _mm256_permute2x128_si256(v, v, 1));
+        m = extreme(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+        m = extreme(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+        auto const mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, m)));
+        return first_lane_of(static_cast<unsigned>(mask));
+    }
+};
+
+template <bool t_select_min>
+struct simd_extreme_t<std::int64_t, t_select_min, 4>
+{
+    static constexpr bool is_enabled = true;
+
+    //!\brief AVX2 has no 64 bit min/max, so select with a (signed) compare and blend.
+    static __m256i extreme(__m256i const lhs, __m256i const rhs)
+    {
+        if constexpr (t_select_min)
+        {
+            return _mm256_blendv_epi8(lhs, rhs, _mm256_cmpgt_epi64(lhs, rhs));
+        }
+        else
+        {
+            return _mm256_blendv_epi8(lhs, rhs, _mm256_cmpgt_epi64(rhs, lhs));
+        }
+    }
+
+    //!\brief Return 'v' with its extreme broadcast to all lanes.
+    static __m256i reduce(__m256i const v)
+    {
+        auto const m = extreme(v, _mm256_permute4x64_epi64(v, _MM_SHUFFLE(1, 0, 3, 2)));
+        return extreme(m, _mm256_permute4x64_epi64(m, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+
+    static int mask_of(__m256i const v, __m256i const m)
+    {
+        return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(v, m)));
+    }
+
+    static std::size_t index_of(std::int64_t const* keys)
+    {
+        auto const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(keys));
+        return first_lane_of(static_cast<unsigned>(mask_of(v, reduce(v))));
+    }
+};
+
+template <bool t_select_min>
+struct simd_extreme_t<std::int64_t, t_select_min, 8>
+{
+    static constexpr bool is_enabled = true;
+
+    using half_type = simd_extreme_t<std::int64_t, t_select_min, 4>;
+
+    static std::size_t index_of(std::int64_t const* keys)
+    {
+        auto const lo = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(keys));
+        auto const hi = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(keys + 4));
+        auto const m = half_type::reduce(half_type::extreme(lo, hi));
+        auto const mask = half_type::mask_of(lo, m) | (half_type::mask_of(hi, m) << 4);
+        return first_lane_of(static_cast<unsigned>(mask));
+    }
+};
+
+//!\brief AVX2 has no unsigned 64 bit compare either, so bias the keys into signed order and select those.
+template <bool t_select_min, std::size_t t_arity>
+struct uint64_extreme_t
+{
+    static constexpr bool is_enabled = true;
+
+    using signed_type = simd_extreme_t<std::int64_t, t_select_min, 4>;
+
+    static __m256i load_signed(std::uint64_t const* keys)
+    {
+        auto const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(keys));
+        return _mm256_xor_si256(v, _mm256_set1_epi64x(std::numeric_limits<std::int64_t>::min()));
+    }
+
+    static std::size_t index_of(std::uint64_t const* keys)
+    {
+        if constexpr (4 == t_arity)
+        {
+            auto const v = load_signed(keys);
+            return first_lane_of(static_cast<unsigned>(signed_type::mask_of(v, signed_type::reduce(v))));
+        }
+        else
+        {
+            auto const lo = load_signed(keys);
+            auto const hi = load_signed(keys + 4);
+            auto const m = signed_type::reduce(signed_type::extreme(lo, hi));
+            auto const mask = signed_type::mask_of(lo, m) | (signed_type::mask_of(hi, m) << 4);
+            return first_lane_of(static_cast<unsigned>(mask));
+        }
+    }
+};
+
+template <bool t_select_min>
+struct simd_extreme_t<std::uint64_t, t_select_min, 4> : uint64_extreme_t<t_select_min, 4> {};
+
+template <bool t_select_min>
+struct simd_extreme_t<std::uint64_t, t_select_min, 8> : uint64_extreme_t<t_select_min, 8> {};
+#endif // #if defined(__AVX2__)
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+template <bool t_select_min>
+struct simd_extreme_t<std::int32_t, t_select_min, 4>
+{
+    static constexpr bool is_enabled = true;
+
+    static std::int32_t extreme(int32x4_t const v)
+    {
+        if constexpr (t_select_min) { return vminvq_s32(v); } else { return vmaxvq_s32(v); }
+    }
+
+    static unsigned mask_of(int32x4_t const v, std::int32_t const m)
+    {
+        static std::uint32_t const lane_bits[4] = { 1, 2, 4, 8 };
+        return vaddvq_u32(vandq_u32(vceqq_s32(v, vdupq_n_s32(m)), vld1q_u32(lane_bits)));
+    }
+
+    static std::size_t index_of(std::int32_t const* keys)
+    {
+        auto const v = vld1q_s32(keys);
+        return first_lane_of(mask_of(v, extreme(v)));
+    }
+};
+
+template <bool t_select_min>
+struct simd_extreme_t<std::uint32_t, t_select_min, 4>
+{
+    static constexpr bool is_enabled = true;
+
+    static std::uint32_t extreme(uint32x4_t const v)
+    {
+        if constexpr (t_select_min) { return vminvq_u32(v); } else { return vmaxvq_u32(v); }
+    }
+
+    static unsigned mask_of(uint32x4_t const v, std::uint32_t const m)
+    {
+        static std::uint32_t const lane_bits[4] = { 1, 2, 4, 8 };
+        return vaddvq_u32(vandq_u32(vceqq_u32(v, vdupq_n_u32(m)), vld1q_u32(lane_bits)));
+    }
+
+    static std::size_t index_of(std::uint32_t const* keys)
+    {
+        auto const v = vld1q_u32(keys);
+        return first_lane_of(mask_of(v, extreme(v)));
+    }
+};
+
+template <bool t_select_min>
+struct simd_extreme_t<float, t_select_min, 4>
+{
+    static constexpr bool is_enabled = true;
+
+    static float extreme(float32x4_t const v)
+    {
+        if constexpr (t_select_min) { return vminvq_f32(v); } else { return vmaxvq_f32(v); }
+    }
+
+    static unsigned mask_of(float32x4_t const v, float const m)
+    {
+        static std::uint32_t const lane_bits[4] = { 1, 2, 4, 8 };
+        return vaddvq_u32(vandq_u32(vceqq_f32(v, vdupq_n_f32(m)), vld1q_u32(lane_bits)));
+    }
+
+    static std::size_t index_of(float const* keys)
+    {
+        auto const v = vld1q_f32(keys);
+        return first_lane_of(mask_of(v, extreme(v)));
+    }
+};
+
+//!\brief 8-ary NEON kernels reduce each half of the siblings, then combine the two halves.
+template <typename t_key_t, bool t_select_min>
+struct neon_extreme_8_t
+{
+    static constexpr bool is_enabled = true;
+
+    using half_type = simd_extreme_t<t_key_t, t_select_min, 4>;
+
+    static std::size_t index_of(t_key_t const* keys)
+    {
+        auto const lo = load(keys);
+        auto const hi = load(keys + 4);
+        auto const lo_m = half_type::extreme(lo);
+        auto const hi_m = half_type::extreme(hi);
+        auto const m = t_select_min ? std::min(lo_m, hi_m) : std::max(lo_m, hi_m);
+        auto const mask = half_type::mask_of(lo, m) | (half_type::mask_of(hi, m) << 4);
+        return first_lane_of(static_cast<unsigned>(mask));
+    }
+
+    static int32x4_t load(std::int32_t const* keys) { return vld1q_s32(keys); }
+    static uint32x4_t load(std::uint32_t const* keys) { return vld1q_u32(keys); }
+    static float32x4_t load(float const* keys) { return vld1q_f32(keys); }
+};
+
+template <bool t_select_min>
+struct simd_extreme_t<std::int32_t, t_select_min, 8> : neon_extreme_8_t<std::int32_t, t_select_min> {};
+
+template <bool t_select_min>
+struct simd_extreme_t<std::uint32_t, t_select_min, 8> : neon_extreme_8_t<std::uint32_t, t_select_min> {};
+
+template <bool t_select_min>
+struct simd_extreme_t<float, t_select_min, 8> : neon_extreme_8_t<float, t_select_min> {};
+#endif // #if defined(__aarch64__) && defined(__ARM_NEON)
+
+//!\brief Return true while being evaluated in a constant expression (std::is_constant_evaluated() before C++20.)
+constexpr bool is_constant_evaluated() noexcept
+{
+#if defined(__cpp_lib_is_constant_evaluated)
+    return std::is_constant_evaluated();
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+/*!
+    \brief Select the child in [first, last) that belongs closest to the root (the leftmost one on ties.)
+
+    A full group of siblings is selected with a SIMD kernel (see simd_extreme_t) when the
+    iterator is contiguous, the comparator is std::less/std::greater (which is how the best
+    child maps onto a vector min/max) and the key type and arity are supported; otherwise
+    the siblings are scanned linearly.  The choice is made at compile time (and in constant
+    expressions, which cannot use SIMD, the siblings are always scanned.)  With
+    't_is_branchless' the scan selects the best index with arithmetic rather than a
+    branch per sibling (see branchless_sift_t.)
+*/
+template <typename t_iter_t, typename t_cmp_op_t, std::size_t t_arity, bool t_is_branchless = false>
+struct select_child_t
+{
+    using iter_type = t_iter_t;
+    using cmp_op_type = t_cmp_op_t;
+    using value_type = typename std::iterator_traits<iter_type>::value_type;
+
+    static constexpr bool is_contiguous = std::is_pointer_v<iter_type>
+        || std::is_same_v<iter_type, typename std::vector<value_type>::iterator>
+        || std::is_same_v<iter_type, typename std::vector<value_type>::const_iterator>;
+    static constexpr bool is_min = std::is_same_v<cmp_op_type, std::less<value_type>>
+        || std::is_same_v<cmp_op_type, std::less<>>;
+    static constexpr bool is_max = std::is_same_v<cmp_op_type, std::greater<value_type>>
+        || std::is_same_v<cmp_op_type, std::greater<>>;
+
+    using simd_type = simd_extreme_t<value_type, is_min, t_arity>;
+
+    static constexpr bool is_simd = is_contiguous && (is_min || is_max) && simd_type::is_enabled;
+
+    constexpr iter_type operator()(iter_type first, iter_type last) const
+    {
+        if constexpr (is_simd)
+        {
+            if (static_cast<std::ptrdiff_t>(t_arity) == last - first && !is_constant_evaluated())
+            {
+                return first + static_cast<std::ptrdiff_t>(simd_type::index_of(&*first));
+            }
+        }
+
+        if constexpr (t_is_branchless)
+        {
+            // best = is_better ? sibling : best, as a multiply-add on the indexes (no jump to mispredict.)
+            std::ptrdiff_t best = 0;
+            for (std::ptrdiff_t sibling = 1; last - first > sibling; ++sibling)
+            {
+                auto const is_better = static_cast<std::ptrdiff_t>(cmp_op_type{}(first[sibling], first[best]));
+                best += (sibling - best) * is_better;
+            }
+            return first + best;
+        }
+
+        auto child = first;
+        for (auto sibling = first + 1; last != sibling; ++sibling)
+        {
+            if (cmp_op_type{}(*sibling, *child))
+            {
+                child = sibling;
+            }
+        }
+
+        return child;
+    }
+};
+
+template <
+    typename t_iter_t
+    , typename t_cmp_op_t = std::greater<
+        typename std::iterator_traits<t_iter_t>::value_type
+    >
+    , std::size_t t_arity = 2
+    , typename t_sift_policy_t = top_down_sift_t
+    , typename t_layout_t = flat_layout_t<t_arity>
+    , typename t_slot_observer_t = null_slot_observer_t
+    , typename t_stats_t = null_stats_t
+>
+struct heapify_down_t
+{
+    static_assert(2 <= t_arity, "A heap node must be able to have at least two children.");
+    static_assert(t_layout_t::arity == t_arity, "The layout must be for the same arity.");
+
+    using iter_type = t_iter_t;
+    using cmp_op_type = t_cmp_op_t;
+    using difference_type = typename std::iterator_traits<iter_type>::difference_type;
+    using value_type = typename std::iterator_traits<iter_type>::value_type;
+    using sift_policy_type = t_sift_policy_t;
+    using layout_type = t_layout_t;
+    using slot_observer_type = t_slot_observer_t;
+    using stats_type = t_stats_t;
+    using sift_traits = sift_policy_traits<sift_policy_type>;
+    using select_child_type = select_child_t<iter_type, cmp_op_type, t_arity, sift_traits::is_branchless>;
+
+    static constexpr std::size_t arity = t_arity;
+    static constexpr bool is_bottom_up = std::is_same_v<typename sift_traits::base_type, bottom_up_sift_t>;
+    static constexpr bool is_prefetching = sift_traits::is_prefetching && select_child_type::is_contiguous;
+    static constexpr std::size_t prefetch_levels = 2 == arity ? 2 : 1; //!< Levels below the children.
+    static constexpr std::size_t cache_line_bytes = 64;
+
+    slot_observer_type observer;
+    stats_type stats = {};
+
+    constexpr void operator()(iter_type begin, iter_type end, iter_type node)
+    {
+        auto const is_leaf = end - begin <= layout_type::first_child(node - begin);
+        if (!is_leaf)
+        {
+            auto value = std::move(*node);
+            stats.move();
+            (*this)(std::move(begin), std::move(end), std::move(node), std::move(value));
+        }
+    }
+
+    //!\brief Heapify 'value' down from the vacant position 'hole' and store it at its final position.
+    constexpr void operator()(iter_type begin, iter_type end, iter_type hole, value_type&& value)
+    {
+        constexpr auto d = static_cast<difference_type>(arity);
+        auto const ary_size = end - begin;
+        auto const top = hole;
+        std::size_t levels = 0;
+        [[maybe_unused]] auto const prefetch = is_prefetching
+            && !is_constant_evaluated()
+            && sift_traits::min_prefetch_heap_bytes / sizeof(value_type) <= static_cast<std::size_t>(ary_size);
+
+        while (true)
+        {
+            auto const first_child_idx = layout_type::first_child(hole - begin);
+            if (ary_size <= first_child_idx)
+            {
+                break;
+            }
+
+            // Select the child that belongs closest to the root (the leftmost one on ties.)
+            auto const last_child_idx = std::min(first_child_idx + d, ary_size);
+            if constexpr (is_prefetching)
+            {
+                if (prefetch)
+                {
+                    prefetch_descendants(begin, first_child_idx, last_child_idx, ary_size);
+                }
+            }
+            auto const child = select_child_type{}(begin + first_child_idx, begin + last_child_idx);
+            stats.compare(static_cast<std::size_t>(last_child_idx - first_child_idx - 1));
+
+            if constexpr (!is_bottom_up)
+            {
+                stats.compare();
+                auto const value_has_stopped_moving = !cmp_op_type{}(*child, value);
+                if (value_has_stopped_moving)
+                {
+                    break;
+                }
+            }
+
+            *hole = std::move(*child);
+            stats.move();
+            observer(begin, hole);
+            hole = child;
+            ++levels;
+        }
+
+        if constexpr (is_bottom_up)
+        {
+            // The hole is now a leaf: heapify the value back up, but never above where it started.
+            while (top < hole)
+            {
+                auto parent = begin + layout_type::parent(hole - begin);
+                stats.compare();
+                if (!cmp_op_type{}(value, *parent))
+                {
+                    break;
+                }
+
+                *hole = std::move(*parent);
+                stats.move();
+                observer(begin, hole);
+                hole = parent;
+                ++levels;
+            }
+        }
+
+        *hole = std::move(value);
+        stats.move();
+        stats.sift(levels);
+        observer(begin, hole);
+    }
+
+private:
+    /*!
+        \brief Prefetch the nodes 'prefetch_levels' levels below the children [first_idx, last_idx),
+               provided that they are contiguous (not spread over the child blocks of a blocked layout.)
+    */
+    static void prefetch_descendants(
+        iter_type const begin
+        , difference_type first_idx
+        , difference_type last_idx
+        , difference_type const ary_size)
+    {
+        constexpr auto d = static_cast<difference_type>(arity);
+        auto max_span = d;
+        for (std::size_t level = 0; prefetch_levels > level; ++level)
+        {
+            first_idx = layout_type::first_child(first_idx);
+            last_idx = layout_type::first_child(last_idx - 1) + d;
+            max_span *= d;
+        }
+        last_idx = std::min(last_idx, ary_size);
+        if (ary_size <= first_idx || max_span < last_idx - first_idx)
+        {
+            return;
+        }
+
+        auto const first_address = reinterpret_cast<std::uintptr_t>(std::addressof(*(begin + first_idx)));
+        auto const last_address = reinterpret_cast<std::uintptr_t>(std::addressof(*(begin + (last_idx - 1))))
+            + sizeof(value_type) - 1;
+        for (auto line = first_address & ~(std::uintptr_t{cache_line_bytes} - 1); last_address >= line;
+            line += cache_line_bytes)
+        {
+            prefetch_for_read(reinterpret_cast<void const*>(line));
+        }
+    }
+};
+
+//!\brief Request parallel execution of an algorithm (see heapify_t, heap_t and heap_sort_t.)
+struct parallel_policy_t
+{
+    std::size_t thread_count = 0; //!< Number of threads to use (0: std::thread::hardware_concurrency().)
+    std::size_t min_nodes_per_thread = 4096; //!< Smaller amounts of work are done serially.
+    //!< Largest temporary buffer (in items) an algorithm may allocate (0: work in place; see heap_sort_t.)
+    std::size_t max_buffer_items = std::numeric_limits<std::size_t>::max();
+
+    [[nodiscard]] std::size_t threads() const
+    {
+        return 0 == thread_count ? std::max<std::size_t>(1, std::thread::hardware_concurrency()) : thread_count;
+    }
+};
+
+/*!
+    \brief Call fn(first, last) for 'thread_count' disjoint sub-ranges of [begin, end) concurrently.
+
+    The calling thread processes the first sub-range itself.  Exceptions thrown by 'fn'
+    are rethrown (the first one) after all sub-ranges have been processed.
+*/
+template <typename t_idx_t, typename t_fn_t>
+void parallel_for_ranges(t_idx_t const begin, t_idx_t const end, std::size_t const thread_count, t_fn_t const& fn)
+{
+    auto const count = static_cast<t_idx_t>(thread_count);
+    auto const chunk = (end - begin + count - 1) / count;
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(thread_count);
+    for (auto first = begin + chunk; end > first; first += chunk)
+    {
+        tasks.emplace_back(std::async(std::launch::async, [&fn, first, last = std::min(first + chunk, end)]{
+            fn(first, last);
+        }));
+    }
+
+    fn(begin, std::min(begin + chunk, end));
+    for (auto& task : tasks)
+    {
+        task.get();
+    }
+}
+
+/*
+    Heap [complete] binary tree is left-weighted and stored in an array.
+
+     0 1 2 3 4 5 6 7 8 9   (array indexes)
+    [0 1 2 3 4 5 6 7 8 9]  (heap)
+
+          Unheapified (usually invalid; happend to be valid min heap due to initial array values):
+
+                0
+             1     2
+           3   4 5   6
+          7 8 9
+
+          Heapified (valid MAX heap):
+
+                9
+             8     5
+           6   7 1   4
+          0 3 2
+    
+     0 1 2 3 4 5 6 7 8 9   (array indexes)
+    [9 8 5 6 7 1 4 0 3 2]  (max heap)
+
+          Heapified (valid MIN heap):
+
+                0
+             1     2
+           3   4 5   6
+          7 8 9
+    
+     0 1 2 3 4 5 6 7 8 9   (array indexes)
+    [0 1 2 3 4 5 6 7 8 9]  (min heap)
+
+    Max heap:
+        o Add node to bottom leftmost available leaf.
+        o Recursively max_heapify_up_t upward while the new value is greater than the parent, until the root is reached.
+
+        for idx in range(0, size(ary)):
+            max_heapify_up_t(ary, idx)
+*/
+template <
+    typename t_iter_t
+    , typename t_cmp_op_t = std::greater<
+        typename std::iterator_traits<t_iter_t>::value_type
+    >
+    , std::size_t t_arity = 2
+    , typename t_sift_policy_t = top_down_sift_t
+    , typename t_layout_t = flat_layout_t<t_arity>
+    , typename t_slot_observer_t = null_slot_observer_t
+    , typename t_stats_t = null_stats_t
+>
+struct heapify_t
+{
+    using iter_type = t_iter_t;
+    using heapify_up_type = heapify_up_t<
+        iter_type
+        , t_cmp_op_t
+        , t_arity
+        , t_layout_t
+        , t_slot_observer_t
+        , t_stats_t
+        , t_sift_policy_t
+    >;
+    using heapify_down_type = heapify_down_t<
+        iter_type
+        , t_cmp_op_t
+        , t_arity
+        , t_sift_policy_t
+        , t_layout_t
+        , t_slot_observer_t
+        , t_stats_t
+    >;
+    using cmp_op_type = t_cmp_op_t;
+    using sift_policy_type = t_sift_policy_t;
+    using layout_type = t_layout_t;
+    using slot_observer_type = t_slot_observer_t;
+    using stats_type = t_stats_t;
+
+    static constexpr std::size_t arity = t_arity;
+
+    slot_observer_type observer;
+    stats_type stats = {};
+
+    constexpr void operator()(iter_type begin, iter_type end)
+    {
+#if 0
+        // Do *NOT* do this!  Time complexity is O(n*log2(n))!
+        for (auto iter = begin; end != iter; ++iter)
+        {
+            heapify_up_type{}(begin, iter);
+        }
+#else // #if 0
+        if (1 < end - begin)
+        {
+            /*
+                Heapify DOWN on ONLY NON-leaf nodes, i.e. 1/2 of the nodes
+                (1/d of the nodes for a d-ary heap), to heapify in O(n) [linear] time! :-)
+                Heapifying up on all nodes produces O(n*log2(n)) time. :-(
+            */
+            auto const last_parent_idx = layout_type::last_parent(end - begin);
+            for (auto iter = begin + last_parent_idx; begin <= iter; --iter)
+            {
+                heapify_down_type{observer, stats}(begin, end, iter);
+            }
+        }
+#endif // #if 0
+    }
+
+    /*!
+        \brief Heapify [begin, end) using multiple threads.
+
+        The subtrees rooted at the nodes of one level are disjoint, so all (parent)
+        nodes of a level can be heapified down concurrently once the level below it
+        is done.  The levels are processed bottom up, in parallel while a level has
+        at least 'min_nodes_per_thread' nodes per thread, and the few remaining top
+        levels serially.  Levels are contiguous index ranges only in the flat layout,
+        so other layouts are heapified serially, and so are heaps that collect stats
+        (the counters are not synchronized.)
+    */
+    void operator()(iter_type begin, iter_type end, parallel_policy_t const& policy)
+    {
+        using difference_type = typename std::iterator_traits<iter_type>::difference_type;
+
+        auto const thread_count = policy.threads();
+        auto const is_flat = is_flat_layout_v<layout_type>;
+        auto const min_level_size = static_cast<difference_type>(thread_count * policy.min_nodes_per_thread);
+        if (!is_flat || stats_type::is_enabled || 1 >= thread_count || end - begin <= min_level_size)
+        {
+            (*this)(std::move(begin), std::move(end));
+            return;
+        }
+
+        // Index of the first node of every level, up to the level below the last parent.
+        constexpr auto d = static_cast<difference_type>(arity);
+        auto const last_parent_idx = layout_type::last_parent(end - begin);
+        std::vector<difference_type> level_begins{0};
+        while (last_parent_idx >= level_begins.back())
+        {
+            level_begins.emplace_back(level_begins.back() * d + 1);
+        }
+
+        auto const heapify_nodes = [&](difference_type const first, difference_type const last){
+            for (auto idx = last; first < idx; --idx)
+            {
+                heapify_down_type{observer, stats}(begin, end, begin + (idx - 1));
+            }
+        };
+        for (auto level = level_begins.size() - 1; 0 < level; --level)
+        {
+            auto const first = level_begins[level - 1];
+            auto const last = std::min(level_begins[level], last_parent_idx + 1);
+            if (min_level_size <= last - first)
+            {
+                parallel_for_ranges(first, last, thread_count, heapify_nodes);
+            }
+            else
+            {
+                heapify_nodes(first, last);
+            }
+        }
+    }
+};
+
+template <
+    typename t_iter_t
+    , std::size_t t_arity = 2
+    , typename t_sift_policy_t = top_down_sift_t
+    , typename t_layout_t = flat_layout_t<t_arity>
+    , typename t_stats_t = null_stats_t
+>
+using max_heapify_t = heapify_t<
+    t_iter_t
+    , std::greater<
+        typename std::iterator_traits<t_iter_t>::value_type
+    >
+    , t_arity
+    , t_sift_policy_t
+    , t_layout_t
+    , null_slot_observer_t
+    , t_stats_t
+>;
+
+template <
+    typename t_iter_t
+    , std::size_t t_arity = 2
+    , typename t_sift_policy_t = top_down_sift_t
+    , typename t_layout_t = flat_layout_t<t_arity>
+    , typename t_stats_t = null_stats_t
+>
+using min_heapify_t = heapify_t<
+    t_iter_t
+    , std::less<
+        typename std::iterator_traits<t_iter_t>::value_type
+    >
+    , t_arity
+    , t_sift_policy_t
+    , t_layout_t
+    , null_slot_observer_t
+    , t_stats_t
+>;
+
+/*!
+    \brief Base of heap_t that owns the heap_stats_t counters its stats policy counts into.
+
+    Empty (and so free, by the empty base optimization) unless stats are enabled;
+    then stats() and reset_stats() are available on the heap.
+*/
+template <typename t_stats_t, bool t_is_enabled = t_stats_t::is_enabled>
+class heap_stats_holder_t
+{
+protected:
+    [[nodiscard]] constexpr t_stats_t stats_policy() const { return t_stats_t{}; }
+};
+
+template <typename t_stats_t>
+class heap_stats_holder_t<t_stats_t, true>
+{
+public:
+    [[nodiscard]] heap_stats_t const& stats() const { return stats_; }
+    void reset_stats() { stats_ = heap_stats_t{}; }
+
+protected:
+    //!\brief Return a stats policy bound to this heap's counters (never stored, so copies stay independent.)
+    [[nodiscard]] t_stats_t stats_policy() { return t_stats_t{&stats_}; }
+
+private:
+    heap_stats_t stats_;
+};
+
+//!\brief Shrink policy for heap_t: storage is only released by shrink_to_fit().
+struct never_shrink_t
+{
+    [[nodiscard]] static constexpr bool should_shrink(std::size_t /*size*/, std::size_t /*capacity*/) { return false; }
+    [[nodiscard]] static constexpr std::size_t shrunk_capacity(std::size_t const size) { return size; }
+};
+
+/*!
+    \brief Shrink policy for heap_t: release storage once the size drops to 1/'t_divisor'
+           of the capacity, leaving room for twice the remaining elements.
+
+    The gap between the shrink threshold and the new capacity is the hysteresis
+    that keeps a heap cycling around one size from reallocating on every
+    push/pop.  Capacities up to 't_min_capacity' are never shrunk.
+*/
+template <std::size_t t_divisor = 4, std::size_t t_min_capacity = 64>
+struct hysteresis_shrink_t
+{
+    static_assert(2 < t_divisor, "Shrinking to twice the size must release storage");
+
+    [[nodiscard]] static constexpr bool should_shrink(std::size_t const size, std::size_t const capacity)
+    {
+        return t_min_capacity < capacity && size * t_divisor <= capacity;
+    }
+
+    [[nodiscard]] static constexpr std::size_t shrunk_capacity(std::size_t const size)
+    {
+        return std::max(size * 2, t_min_capacity);
+    }
+};
+
+//!\brief Tag for heap_t's constructor that adopts a container already in heap order (see heap_ordered.)
+struct heap_ordered_t
+{
+    explicit heap_ordered_t() = default;
+};
+
+inline constexpr heap_ordered_t heap_ordered{};
+
+template <
+    typename t_item_t
+    , typename t_container_t = std::vector<t_item_t>
+    , typename t_heapify_t = max_heapify_t<typename t_container_t::iterator>
+    , typename t_shrink_policy_t = never_shrink_t
+>
+class heap_t : public heap_stats_holder_t<typename t_heapify_t::stats_type>
+{
+public:
+    using item_type = t_item_t;
+    using container_t = t_container_t;
+    using allocator_type = typename container_t::allocator_type;
+    using shrink_policy_type = t_shrink_policy_t;
+    using iterator = typename container_t::iterator;
+    using const_iterator = typename container_t::const_iterator;
+    using heapify_type = t_heapify_t;
+    using heapify_up_type = typename heapify_type::heapify_up_type;
+    using heapify_down_type = typename heapify_type::heapify_down_type;
+    using cmp_op_type = typename heapify_type::cmp_op_type;
+    using sift_policy_type = typename heapify_type::sift_policy_type;
+    using layout_type = typename heapify_type::layout_type;
+    using stats_type = typename heapify_type::stats_type;
+
+    static constexpr std::size_t arity = heapify_type::arity;
+
+    heap_t() = default;
+
+    //!\brief Initialize an empty heap whose storage comes from 'allocator' (e.g. a std::pmr arena.)
+    explicit heap_t(allocator_type const& allocator)
+        : array_(allocator)
+    {
+        // Do nothing.
+    }
+
+    //!\brief Initialize from array.
+    template<typename A, std::size_t S>
+    heap_t(A const (&ary)[S])
+        : heap_t{ary, ary + S}
+    {
+        // Do nothing.
+    }
+
+    //!\brief Initialize from begin/end iterator pair.
+    template<typename I>
+    heap_t(I begin, I end)
+        : array_(begin, end)
+    {
+        heapify_type{{}, this->stats_policy()}(this->begin(), this->end());
+        check_invariant();
+    }
+
+    //!\brief Initialize from begin/end iterator pair, with storage from 'allocator'.
+    template<typename I>
+    heap_t(I begin, I end, allocator_type const& allocator)
+        : array_(begin, end, allocator)
+    {
+        heapify_type{{}, this->stats_policy()}(this->begin(), this->end());
+        check_invariant();
+    }
+
+    //!\brief Adopt 'items', which are already in heap order (e.g. a snapshot); nothing is heapified.
+    heap_t(heap_ordered_t, container_t items)
+        : array_(std::move(items))
+    {
+        check_invariant();
+    }
+
+    //!\brief Initialize from begin/end iterator pair, heapifying with multiple threads.
+    template<typename I>
+    heap_t(parallel_policy_t const& policy, I begin, I end)
+        : array_(begin, end)
+    {
+        heapify_type{{}, this->stats_policy()}(this->begin(), this->end(), policy);
+        check_invariant();
+    }
+    
+#if 0
+    // //!\brief Initialize from initializer list.
+    heap_t(std::initializer_list<item_type> list)
+        : array_(list.begin(), list.end())
+    {
+        heapify_type{{}, this->stats_policy()}(array_.begin(), array_.end());
+    }
+#endif // #if 0
+    
+    //!\brief Initialize from initializer list, e.g. {1, 2, 3, 4, 5}.
+    template<typename... t_vals_t>
+    heap_t(item_type&& val1, t_vals_t&&... value)
+    {
+        // Not an std::initializer_list: its elements can only be copied (not moved) out.
+        array_.reserve(1 + sizeof...(value));
+        array_.emplace_back(std::move(val1));
+        (array_.emplace_back(std::forward<t_vals_t>(value)), ...);
+        heapify_type{{}, this->stats_policy()}(begin(), end());
+        check_invariant();
+    }
+
+    [[nodiscard]] iterator begin() { return array_.begin(); }
+    [[nodiscard]] iterator end() { return array_.end(); }
+
+    [[nodiscard]] const_iterator begin() const { return array_.begin(); }
+    [[nodiscard]] const_iterator end() const { return array_.end(); }
+
+    [[nodiscard]] std::size_t size() const { return array_.size(); }
+    [[nodiscard]] bool empty() const { return array_.empty(); }
+    [[nodiscard]] std::size_t capacity() const { return array_.capacity(); }
+    [[nodiscard]] allocator_type get_allocator() const { return array_.get_allocator(); }
+
+    //!\brief Pre-size the storage for 'count' elements, so pushes do not reallocate.
+    void reserve(std::size_t const count) { array_.reserve(count); }
+
+    //!\brief Release unused storage (regardless of the shrink policy.)
+    void shrink_to_fit() { shrink_to(size()); }
+    
+    [[nodiscard]] auto const& operator[](std::size_t idx) const { return array_[idx]; }
+    
+    //!\brief Return the head element of the heap.
+    [[nodiscard]] item_type const& top() const
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        return array_.front();
+    }
+    
+    //!\brief Remove the head element from the heap and return it (moved, not copied, out of the root.)
+    [[nodiscard]] item_type pop_value()
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        auto result = std::move(array_.front());
+        pop();
+        return result;
+    }
+    
+    //!\brief Remove the head element from the heap.
+    void pop()
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        auto value = std::move(array_.back());
+        array_.pop_back();
+        if (!empty())
+        {
+            // The root is the hole; heapify the (former) last item down from it.
+            heapify_down_type{{}, this->stats_policy()}(begin(), end(), begin(), std::move(value));
+        }
+        apply_shrink_policy();
+        check_invariant();
+    }
+
+    /*!
+        \brief Remove the element at 'position' (e.g. a cancelled timer) from the heap.
+
+        The last element is moved into the hole and heapified up or down from there,
+        so this is a single O(log(n)) sift.
+    */
+    void erase(const_iterator const position)
+    {
+        auto const hole = begin() + (position - std::as_const(array_).begin());
+        auto value = std::move(array_.back());
+        array_.pop_back();
+        if (end() != hole)
+        {
+            // The former last element moves up only if it belongs above the erased element.
+            auto move_value_up_tree = false;
+            if (begin() != hole)
+            {
+                this->stats_policy().compare();
+                move_value_up_tree = cmp_op_type{}(value, *hole);
+            }
+            if (move_value_up_tree)
+            {
+                heapify_up_type{{}, this->stats_policy()}(begin(), hole, std::move(value));
+            }
+            else
+            {
+                heapify_down_type{{}, this->stats_policy()}(begin(), end(), hole, std::move(value));
+            }
+        }
+        apply_shrink_policy();
+        check_invariant();
+    }
+
+    /*!
+        \brief Remove all elements for which 'pred' returns true; return the number removed.
+
+        The array is compacted in a single pass and then heapified once, O(n), which
+        is cheaper than an erase() per element unless only a few are removed.
+    */
+    template<typename t_pred_t>
+    std::size_t erase_if(t_pred_t pred)
+    {
+        auto const first_erased = std::remove_if(begin(), end(), std::move(pred));
+        auto const count = static_cast<std::size_t>(end() - first_erased);
+        if (0 < count)
+        {
+            array_.erase(first_erased, end());
+            heapify_type{{}, this->stats_policy()}(begin(), end());
+            apply_shrink_policy();
+        }
+        check_invariant();
+
+        return count;
+    }
+
+    //!\todo Add an element to the heap.
+    heap_t& push(item_type value)
+    {
+        return emplace(std::move(value));
+    }
+
+    //!\brief Add an element, constructed in place from 'args', to the heap.
+    template<typename... t_args_t>
+    heap_t& emplace(t_args_t&&... args)
+    {
+        // Add the item to the leftmost available child position in the tree.
+        // (Append the item to the array.)
+        array_.emplace_back(std::forward<t_args_t>(args)...);
+
+        // Heapify, starting from the new child to correctly position it within the tree.
+        heapify_up_type{{}, this->stats_policy()}(begin(), end() - 1);
+        check_invariant();
+
+        return *this;
+    }
+
+    /*!
+        \brief Replace the head element with 'value' and return the former head element.
+
+        Equivalent to pop_value() followed by push(value), but with a single heapify
+        down from the root and no change of the container's size.
+    */
+    [[nodiscard]] item_type replace_top(item_type value)
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        auto result = std::move(array_.front());
+        // The root is the hole; heapify the new value down from it.
+        heapify_down_type{{}, this->stats_policy()}(begin(), end(), begin(), std::move(value));
+        check_invariant();
+        return result;
+    }
+
+    /*!
+        \brief Add 'value' to the heap, then remove the head element and return it.
+
+        Equivalent to push(value) followed by pop_value(), but if 'value' would be the
+        new head element it is returned right away (the heap is not touched), and
+        otherwise this is a replace_top(value).
+    */
+    [[nodiscard]] item_type push_pop(item_type value)
+    {
+        if (empty())
+        {
+            return value;
+        }
+
+        this->stats_policy().compare();
+        auto const value_is_head = !cmp_op_type{}(array_.front(), value);
+        if (value_is_head)
+        {
+            return value;
+        }
+
+        return replace_top(std::move(value));
+    }
+
+    /*!
+        \brief Move the (up to) 'count' head elements out of the heap, in order, to 'out'.
+
+        Equivalent to calling pop_value() 'count' times, but each element is moved
+        (not copied) and the container is shrunk only once.
+        \return The output iterator one past the last element written.
+    */
+    template<typename O>
+    O pop_n(std::size_t count, O out)
+    {
+        count = std::min(count, size());
+        auto last = end();
+        for (std::size_t idx = 0; count > idx; ++idx)
+        {
+            *out = std::move(*begin());
+            ++out;
+            --last;
+            if (begin() != last)
+            {
+                // The root is the hole; heapify the last item down from it.
+                auto value = std::move(*last);
+                heapify_down_type{{}, this->stats_policy()}(begin(), last, begin(), std::move(value));
+            }
+        }
+        array_.erase(last, end());
+        apply_shrink_policy();
+        check_invariant();
+
+        return out;
+    }
+
+    /*!
+        \brief Add all elements of [first, last) to the heap.
+
+        The elements are appended to the array in one go and then either heapified
+        up one at a time (O(k*log(n))) or the whole array is reheapified (O(n + k)),
+        whichever is expected to be cheaper for this batch size.
+    */
+    template<typename I>
+    heap_t& push_range(I first, I last)
+    {
+        auto const old_size = size();
+        array_.insert(array_.end(), std::move(first), std::move(last));
+        heapify_appended(old_size);
+
+        return *this;
+    }
+
+    //!\brief Move all elements of 'items' into the heap (see push_range().)
+    heap_t& append(container_t&& items)
+    {
+        auto const old_size = size();
+        if (empty())
+        {
+            array_ = std::move(items);
+        }
+        else
+        {
+            array_.insert(array_.end(), std::make_move_iterator(items.begin()), std::make_move_iterator(items.end()));
+        }
+        items.clear();
+        heapify_appended(old_size);
+
+        return *this;
+    }
+
+    //!\brief Move all elements of 'other' into this heap, leaving 'other' empty.
+    heap_t& merge(heap_t&& other)
+    {
+        // Append the smaller heap to the larger one; append() then picks pushing each vs. reheapifying.
+        if (size() < other.size())
+        {
+            std::swap(array_, other.array_);
+        }
+
+        return append(std::move(other.array_));
+    }
+
+    //!\brief Add an element to or replace an element in the heap.
+    heap_t& insert(iterator position, item_type value)
+    {
+        if (end() == position)
+        {
+            push(std::move(value));
+        }
+        else if (*position == value)
+        {
+            // Update existing item (in case updating has side effects.)
+            *position = std::move(value);
+        }
+        else
+        {
+            // The replaced item's position is the hole the new value is heapified from.
+            this->stats_policy().compare();
+            auto const move_value_up_tree = cmp_op_type{}(value, *position);
+            if (move_value_up_tree)
+            {
+                heapify_up_type{{}, this->stats_policy()}(begin(), std::move(position), std::move(value));
+            }
+            else
+            {
+                heapify_down_type{{}, this->stats_policy()}(begin(), end(), std::move(position), std::move(value));
+            }
+        }
+        check_invariant();
+
+        return *this;
+    }
+
+private:
+    //!\brief Return true if reheapifying n + k items is expected to be cheaper than k individual pushes.
+    [[nodiscard]] static bool reheapify_is_cheaper(std::size_t const old_size, std::size_t const batch_size)
+    {
+        auto const new_size = old_size + batch_size;
+        std::size_t levels = 0;
+        for (auto remaining = new_size; 0 < remaining; remaining /= arity)
+        {
+            ++levels;
+        }
+
+        return new_size <= batch_size * levels;
+    }
+
+    //!\brief Restore the heap after items were appended behind the first 'old_size' (heapified) items.
+    void heapify_appended(std::size_t const old_size)
+    {
+        auto const batch_size = size() - old_size;
+        if (reheapify_is_cheaper(old_size, batch_size))
+        {
+            heapify_type{{}, this->stats_policy()}(begin(), end());
+        }
+        else
+        {
+            for (auto iter = begin() + static_cast<std::ptrdiff_t>(old_size); end() != iter; ++iter)
+            {
+                heapify_up_type{{}, this->stats_policy()}(begin(), iter);
+            }
+        }
+        check_invariant();
+    }
+
+    //!\brief Let the stats policy check the whole heap (e.g. that the heap order holds.)
+    void check_invariant()
+    {
+        this->stats_policy().check(begin(), end(), cmp_op_type{}, layout_type{});
+    }
+
+    void apply_shrink_policy()
+    {
+        if (shrink_policy_type::should_shrink(size(), capacity()))
+        {
+            shrink_to(shrink_policy_type::shrunk_capacity(size()));
+        }
+    }
+
+    //!\brief Reallocate the storage (from the same allocator) with room for 'new_capacity' elements.
+    void shrink_to(std::size_t const new_capacity)
+    {
+        if (capacity() <= new_capacity)
+        {
+            return;
+        }
+
+        container_t shrunk(array_.get_allocator());
+        shrunk.reserve(new_capacity);
+        shrunk.insert(shrunk.end(), std::make_move_iterator(begin()), std::make_move_iterator(end()));
+        array_.swap(shrunk);
+    }
+
+    container_t array_;
+};
+
+template <
+    typename t_item_t
+    , std::size_t t_arity = 2
+    , typename t_sift_policy_t = top_down_sift_t
+    , typename t_layout_t = flat_layout_t<t_arity>
+    , typename t_stats_t = null_stats_t
+>
+using max_heap_t = heap_t<
+    t_item_t
+    , std::vector<t_item_t>
+    , max_heapify_t<typename std::vector<t_item_t>::iterator, t_arity, t_sift_policy_t, t_layout_t, t_stats_t>
+>;
+
+template <
+    typename t_item_t
+    , std::size_t t_arity = 2
+    , typename t_sift_policy_t = top_down_sift_t
+    , typename t_layout_t = flat_layout_t<t_arity>
+    , typename t_stats_t = null_stats_t
+>
+using min_heap_t = heap_t<
+    t_item_t
+    , std::vector<t_item_t>
+    , min_heapify_t<typename std::vector<t_item_t>::iterator, t_arity, t_sift_policy_t, t_layout_t, t_stats_t>
+>;
+
+//!\brief max_heap_t whose storage comes from a std::pmr::memory_resource (e.g. a per request arena.)
+template <
+    typename t_item_t
+    , std::size_t t_arity = 2
+    , typename t_sift_policy_t = top_down_sift_t
+    , typename t_layout_t = flat_layout_t<t_arity>
+>
+using pmr_max_heap_t = heap_t<
+    t_item_t
+    , std::pmr::vector<t_item_t>
+    , max_heapify_t<typename std::pmr::vector<t_item_t>::iterator, t_arity, t_sift_policy_t, t_layout_t>
+>;
+
+//!\brief min_heap_t whose storage comes from a std::pmr::memory_resource (e.g. a per request arena.)
+template <
+    typename t_item_t
+    , std::size_t t_arity = 2
+    , typename t_sift_policy_t = top_down_sift_t
+    , typename t_layout_t = flat_layout_t<t_arity>
+>
+using pmr_min_heap_t = heap_t<
+    t_item_t
+    , std::pmr::vector<t_item_t>
+    , min_heapify_t<typename std::pmr::vector<t_item_t>::iterator, t_arity, t_sift_policy_t, t_layout_t>
+>;
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+/*!
+    \brief Codec that packs a priority (of up to 32 bits) and a 32 bit payload (e.g. an
+           index into a side table) into one std::uint64_t, ordered by the priority.
+
+    The high word holds an order preserving encoding of the priority, the low word the
+    payload, so comparing keys as plain integers compares their priorities first (and
+    their payloads on ties.)  A heap of these keys (packed_max_heap_t, packed_min_heap_t)
+    replaces the lexicographic, branching comparison of a std::pair<priority, index> by
+    a single integer compare, and so can select children branchlessly (its default sift
+    policy) or, with AVX2, with SIMD.
+
+    Signed integers are encoded by flipping their sign bit; floating point numbers by
+    flipping the sign bit of non-negative ones and all bits of negative ones, which
+    orders -0.0 before +0.0 and NaNs beyond the infinities (by their sign.)
+*/
+template <typename t_priority_t>
+struct packed_key_t
+{
+    using priority_type = t_priority_t;
+    using key_type = std::uint64_t;
+    using payload_type = std::uint32_t;
+
+    static_assert(
+        (std::is_integral_v<priority_type> && !std::is_same_v<bool, priority_type>)
+            || (std::is_floating_point_v<priority_type> && std::numeric_limits<priority_type>::is_iec559)
+        , "packed_key_t needs an integral or IEEE 754 floating point priority.");
+    static_assert(sizeof(priority_type) <= sizeof(std::uint32_t), "packed_key_t priorities are at most 32 bits.");
+
+    static constexpr std::uint32_t sign_bit = std::uint32_t{1} << 31;
+
+    //!\brief Return the key of 'priority' and 'payload'.
+    [[nodiscard]] static key_type encode(priority_type const priority, payload_type const payload)
+    {
+        return (key_type{sortable_bits(priority)} << 32) | payload;
+    }
+
+    //!\brief Return the priority that 'key' was encoded from.
+    [[nodiscard]] static priority_type priority(key_type const key)
+    {
+        return from_sortable_bits(static_cast<std::uint32_t>(key >> 32));
+    }
+
+    //!\brief Return the payload that 'key' was encoded from.
+    [[nodiscard]] static payload_type payload(key_type const key)
+    {
+        return static_cast<payload_type>(key);
+    }
+
+    //!\brief Return the priority and payload that 'key' was encoded from.
+    [[nodiscard]] static std::pair<priority_type, payload_type> decode(key_type const key)
+    {
+        return {priority(key), payload(key)};
+    }
+
+    //!\brief Return 32 bits that compare (as unsigned integers) like 'priority' does.
+    [[nodiscard]] static std::uint32_t sortable_bits(priority_type const priority)
+    {
+        if constexpr (std::is_floating_point_v<priority_type>)
+        {
+            static_assert(sizeof(float) == sizeof(priority_type), "packed_key_t supports float (not double.)");
+            std::uint32_t bits = 0;
+            std::memcpy(&bits, &priority, sizeof(bits));
+            return 0 != (bits & sign_bit) ? ~bits : bits ^ sign_bit;
+        }
+        else if constexpr (std::is_signed_v<priority_type>)
+        {
+            return static_cast<std::uint32_t>(static_cast<std::int32_t>(priority)) ^ sign_bit;
+        }
+        else
+        {
+            return static_cast<std::uint32_t>(priority);
+        }
+    }
+
+    //!\brief Return the priority whose sortable_bits() are 'bits'.
+    [[nodiscard]] static priority_type from_sortable_bits(std::uint32_t const bits)
+    {
+        if constexpr (std::is_floating_point_v<priority_type>)
+        {
+            std::uint32_t const raw = 0 != (bits & sign_bit) ? bits ^ sign_bit : ~bits;
+            priority_type result{};
+            std::memcpy(&result, &raw, sizeof(result));
+            return result;
+        }
+        else if constexpr (std::is_signed_v<priority_type>)
+        {
+            return static_cast<priority_type>(static_cast<std::int32_t>(bits ^ sign_bit));
+        }
+        else
+        {
+            return static_cast<priority_type>(bits);
+        }
+    }
+};
+
+//!\brief max_heap_t of packed_key_t keys (the highest priority on top; of equal ones, the highest payload.)
+template <
+    std::size_t t_arity = 2
+    , typename t_sift_policy_t = branchless_sift_t<>
+    , typename t_layout_t = flat_layout_t<t_arity>
+    , typename t_stats_t = null_stats_t
+>
+using packed_max_heap_t = max_heap_t<std::uint64_t, t_arity, t_sift_policy_t, t_layout_t, t_stats_t>;
+
+//!\brief min_heap_t of packed_key_t keys (the lowest priority on top; of equal ones, the lowest payload.)
+template <
+    std::size_t t_arity = 2
+    , typename t_sift_policy_t = branchless_sift_t<>
+    , typename t_layout_t = flat_layout_t<t_arity>
+    , typename t_stats_t = null_stats_t
+>
+using packed_min_heap_t = min_heap_t<std::uint64_t, t_arity, t_sift_policy_t, t_layout_t, t_stats_t>;
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+/*!
+    \brief Heap adaptor with lazy deletion: items are erased by marking them dead.
+
+    An item is erased by setting its own "dead" state (e.g. a cancelled timer's
+    flag, which 't_is_dead_t' reads) and calling note_dead().  Dead items are
+    skipped, i.e. popped, once they reach the top, and once more than the
+    'max_dead_fraction' of the heap is dead they are all erased at once: one
+    erase_if(), i.e. one pass and one heapify.  The counts rely on note_dead()
+    being called once per item that dies while in the heap.
+*/
+template <
+    typename t_item_t
+    , typename t_is_dead_t
+    , typename t_heap_t = max_heap_t<t_item_t>
+>
+class tombstone_heap_t
+{
+public:
+    using item_type = t_item_t;
+    using is_dead_type = t_is_dead_t;
+    using heap_type = t_heap_t;
+
+    explicit tombstone_heap_t(double const max_dead_fraction = 0.25)
+        : max_dead_fraction_{max_dead_fraction}
+    {
+        // Do nothing.
+    }
+
+    //!\brief Return the number of live elements.
+    [[nodiscard]] std::size_t size() const { return heap_.size() - dead_count_; }
+    [[nodiscard]] bool empty() const { return 0 == size(); }
+
+    //!\brief Return the number of dead elements still in the heap.
+    [[nodiscard]] std::size_t dead_count() const { return dead_count_; }
+
+    //!\brief Return the underlying heap (with its dead elements.)
+    [[nodiscard]] heap_type const& heap() const { return heap_; }
+
+    //!\brief Return the head live element (after dropping the dead ones above it.)
+    [[nodiscard]] item_type const& top()
+    {
+        drop_dead_top();
+        return heap_.top();
+    }
+
+    //!\brief Remove the head live element from the heap and return it.
+    [[nodiscard]] item_type pop_value()
+    {
+        drop_dead_top();
+        return heap_.pop_value();
+    }
+
+    //!\brief Remove the head live element from the heap.
+    void pop()
+    {
+        drop_dead_top();
+        heap_.pop();
+    }
+
+    //!\brief Add an element to the heap.
+    tombstone_heap_t& push(item_type value)
+    {
+        heap_.push(std::move(value));
+        return *this;
+    }
+
+    //!\brief Record that 'count' elements in the heap were marked dead; compact() if too many are.
+    void note_dead(std::size_t const count = 1)
+    {
+        dead_count_ = std::min(heap_.size(), dead_count_ + count);
+        if (static_cast<double>(dead_count_) > max_dead_fraction_ * static_cast<double>(heap_.size()))
+        {
+            compact();
+        }
+    }
+
+    //!\brief Erase all dead elements.
+    void compact()
+    {
+        static_cast<void>(heap_.erase_if(is_dead_type{}));
+        dead_count_ = 0;
+    }
+
+private:
+    void drop_dead_top()
+    {
+        while (!heap_.empty() && is_dead_type{}(heap_.top()))
+        {
+            heap_.pop();
+            dead_count_ -= std::min<std::size_t>(1, dead_count_);
+        }
+    }
+
+    heap_type heap_;
+    std::size_t dead_count_ = 0;
+    double max_dead_fraction_;
+};
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+#if defined(__unix__) || defined(__APPLE__)
+
+//!\brief Where an mmap_vector_t keeps its items (heap_t passes it through like an allocator.)
+struct mmap_storage_t
+{
+    std::string directory;          //!< Directory of the (unlinked) backing file; empty: $TMPDIR, else /tmp.
+    std::size_t resident_bytes = 0; //!< Leading bytes (the top levels of a heap) to lock in RAM, if permitted.
+};
+
+/*!
+    \brief Vector-like heap_t container whose items live in a memory-mapped file.
+
+    A heap larger than RAM then pages to its backing file, an unlinked temporary
+    file that goes away with the container, instead of growing until the process
+    is OOM-killed.  The first 'resident_bytes' of the mapping, where the flat and
+    blocked layouts both keep the top levels of the tree, are locked in RAM (best
+    effort: it is skipped if RLIMIT_MEMLOCK does not allow it.)  Use it with a
+    page_blocked_layout_t (see mmap_max_heap_t): a sift then touches one page per
+    block of levels, i.e. O(log(n)/log(B)) pages for B items per page, and page
+    write back is batched by the OS.  The storage grows geometrically by extending
+    the file and remapping it, so items must be trivially copyable.  map_file()
+    adopts items stored in an existing file (e.g. a heap snapshot), copy-on-write;
+    they are only copied to a backing file of their own once the vector grows.
+*/
+template <typename t_item_t>
+class mmap_vector_t
+{
+public:
+    static_assert(std::is_trivially_copyable_v<t_item_t>, "Items are paged out and remapped as raw bytes");
+
+    using value_type = t_item_t;
+    using allocator_type = mmap_storage_t;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using iterator = value_type*;
+    using const_iterator = value_type const*;
+
+    mmap_vector_t() = default;
+
+    explicit mmap_vector_t(allocator_type storage)
+        : storage_{std::move(storage)}
+    {
+        // Do nothing.
+    }
+
+    template <typename I>
+    mmap_vector_t(I first, I last, allocator_type storage = {})
+        : storage_{std::move(storage)}
+    {
+        insert(end(), std::move(first), std::move(last));
+    }
+
+    mmap_vector_t(mmap_vector_t const& other)
+        : storage_{other.storage_}
+    {
+        insert(end(), other.begin(), other.end());
+    }
+
+    mmap_vector_t(mmap_vector_t&& other) noexcept { swap(other); }
+
+    mmap_vector_t& operator=(mmap_vector_t other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    ~mmap_vector_t() { release(); }
+
+    /*!
+        \brief Return a vector of the 'count' items stored at byte 'offset' of the file 'path'.
+
+        The file is mapped privately: changes to the items are not written back to it.
+    */
+    [[nodiscard]] static mmap_vector_t map_file(
+        std::string const& path
+        , std::size_t const offset
+        , std::size_t const count
+        , allocator_type storage = {})
+    {
+        if (0 != offset % alignof(value_type)) { throw std::invalid_argument{"misaligned items"}; }
+
+        auto const fd = ::open(path.c_str(), O_RDONLY);
+        if (0 > fd) { throw_system_error("open"); }
+        struct stat status = {};
+        if (0 != ::fstat(fd, &status))
+        {
+            ::close(fd);
+            throw_system_error("fstat");
+        }
+        auto const bytes = static_cast<std::size_t>(status.st_size);
+        if (bytes < offset || (bytes - offset) / sizeof(value_type) < count)
+        {
+            ::close(fd);
+            throw std::runtime_error{"file is too short"};
+        }
+        auto* const mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        ::close(fd); // The mapping keeps the file.
+        if (MAP_FAILED == mapping) { throw_system_error("mmap"); }
+
+        auto items = mmap_vector_t{std::move(storage)};
+        items.mapping_ = mapping;
+        items.bytes_ = bytes;
+        items.data_ = reinterpret_cast<value_type*>(static_cast<char*>(mapping) + offset);
+        items.size_ = items.capacity_ = count;
+        items.lock_resident();
+        return items;
+    }
+
+    [[nodiscard]] iterator begin() { return data_; }
+    [[nodiscard]] iterator end() { return data_ + size_; }
+    [[nodiscard]] const_iterator begin() const { return data_; }
+    [[nodiscard]] const_iterator end() const { return data_ + size_; }
+
+    [[nodiscard]] value_type* data() { return data_; }
+    [[nodiscard]] value_type const* data() const { return data_; }
+    [[nodiscard]] std::size_t size() const { return size_; }
+    [[nodiscard]] bool empty() const { return 0 == size_; }
+    [[nodiscard]] std::size_t capacity() const { return capacity_; }
+    [[nodiscard]] allocator_type get_allocator() const { return storage_; }
+
+    [[nodiscard]] reference operator[](std::size_t const idx) { return data_[idx]; }
+    [[nodiscard]] const_reference operator[](std::size_t const idx) const { return data_[idx]; }
+    [[nodiscard]] reference front() { return data_[0]; }
+    [[nodiscard]] const_reference front() const { return data_[0]; }
+    [[nodiscard]] reference back() { return data_[size_ - 1]; }
+    [[nodiscard]] const_reference back() const { return data_[size_ - 1]; }
+
+    //!\brief Extend the backing file and the mapping to hold at least 'count' items.
+    void reserve(std::size_t const count)
+    {
+        if (capacity_ < count)
+        {
+            remap(count);
+        }
+    }
+
+    //!\brief Truncate the backing file and the mapping to the pages in use.
+    void shrink_to_fit()
+    {
+        if (capacity_ > size_)
+        {
+            remap(size_);
+        }
+    }
+
+    template <typename... t_args_t>
+    reference emplace_back(t_args_t&&... args)
+    {
+        if (capacity_ == size_)
+        {
+            remap(std::max(2 * capacity_, std::max<std::size_t>(1, page_size() / sizeof(value_type))));
+        }
+        auto* const item = ::new (static_cast<void*>(data_ + size_)) value_type(std::forward<t_args_t>(args)...);
+        ++size_;
+        return *item;
+    }
+
+    void push_back(value_type const& value) { emplace_back(value); }
+    void pop_back() { --size_; } // Trivially destructible.
+    void clear() { size_ = 0; }
+
+    //!\brief Drop the items after the first 'count', or append value initialized items up to 'count'.
+    void resize(std::size_t const count)
+    {
+        reserve(count);
+        while (count > size_)
+        {
+            emplace_back();
+        }
+        size_ = count;
+    }
+
+    //!\brief Insert [first, last) before 'position'; return an iterator to the first inserted item.
+    template <typename I>
+    iterator insert(const_iterator const position, I first, I last)
+    {
+        auto const offset = position - begin();
+        auto const old_size = size_;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<I>::iterator_category>)
+        {
+            reserve(size_ + static_cast<std::size_t>(std::distance(first, last)));
+        }
+        for (; last != first; ++first)
+        {
+            emplace_back(*first);
+        }
+        std::rotate(begin() + offset, begin() + old_size, end());
+        return begin() + offset;
+    }
+
+    //!\brief Remove [first, last); return an iterator to the item after them.
+    iterator erase(const_iterator const first, const_iterator const last)
+    {
+        auto const hole = begin() + (first - begin());
+        std::move(begin() + (last - begin()), end(), hole);
+        size_ -= static_cast<std::size_t>(last - first);
+        return hole;
+    }
+
+    void swap(mmap_vector_t& other) noexcept
+    {
+        std::swap(storage_, other.storage_);
+        std::swap(fd_, other.fd_);
+        std::swap(mapping_, other.mapping_);
+        std::swap(data_, other.data_);
+        std::swap(bytes_, other.bytes_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+private:
+    [[nodiscard]] static std::size_t page_size() { return static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)); }
+
+    [[noreturn]] static void throw_system_error(char const* what)
+    {
+        throw std::system_error{errno, std::generic_category(), what};
+    }
+
+    //!\brief Create the backing file, unlinked so that it is removed once it is closed.
+    void open_file()
+    {
+        auto directory = storage_.directory;
+        if (directory.empty())
+        {
+            auto const* const tmpdir = std::getenv("TMPDIR");
+            directory = nullptr != tmpdir && '\0' != *tmpdir ? tmpdir : "/tmp";
+        }
+        auto path = directory + "/heap_XXXXXX";
+        fd_ = ::mkstemp(path.data());
+        if (0 > fd_) { throw_system_error("mkstemp"); }
+        ::unlink(path.c_str());
+    }
+
+    /*!
+        \brief Resize the backing file to the pages of 'new_capacity' items and map it again.
+
+        The new mapping is another view of the same file, so the items are not copied;
+        the file is only truncated (when shrinking) once the old mapping is gone.  The
+        items of a map_file() vector are copied to a new backing file (once.)
+    */
+    void remap(std::size_t const new_capacity)
+    {
+        auto const is_mapped_file = nullptr != mapping_ && 0 > fd_;
+        if (0 > fd_)
+        {
+            open_file();
+        }
+
+        auto const page = page_size();
+        auto const new_bytes = std::max<std::size_t>(1, (new_capacity * sizeof(value_type) + page - 1) / page) * page;
+        if ((is_mapped_file || bytes_ < new_bytes) && 0 != ::ftruncate(fd_, static_cast<off_t>(new_bytes)))
+        {
+            throw_system_error("ftruncate");
+        }
+        auto* const mapping = ::mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (MAP_FAILED == mapping) { throw_system_error("mmap"); }
+        if (is_mapped_file)
+        {
+            std::memcpy(mapping, data_, size_ * sizeof(value_type));
+        }
+        if (nullptr != mapping_)
+        {
+            ::munmap(mapping_, bytes_);
+        }
+        if (!is_mapped_file && bytes_ > new_bytes)
+        {
+            static_cast<void>(::ftruncate(fd_, static_cast<off_t>(new_bytes))); // Only gives disk space back.
+        }
+
+        mapping_ = mapping;
+        data_ = static_cast<value_type*>(mapping);
+        bytes_ = new_bytes;
+        capacity_ = new_bytes / sizeof(value_type);
+        lock_resident();
+    }
+
+    void lock_resident() const
+    {
+        if (0 < storage_.resident_bytes)
+        {
+            static_cast<void>(::mlock(data_, std::min(capacity_ * sizeof(value_type), storage_.resident_bytes)));
+        }
+    }
+
+    void release()
+    {
+        if (nullptr != mapping_)
+        {
+            ::munmap(mapping_, bytes_);
+        }
+        if (0 <= fd_)
+        {
+            ::close(fd_);
+        }
+        mapping_ = nullptr;
+        data_ = nullptr;
+        fd_ = -1;
+        bytes_ = size_ = capacity_ = 0;
+    }
+
+    mmap_storage_t storage_;
+    int fd_ = -1; //!< The backing file (none for a map_file() vector.)
+    void* mapping_ = nullptr;
+    value_type* data_ = nullptr; //!< The items, at the start of the mapping but for a map_file() vector.
+    std::size_t bytes_ = 0; //!< Size of the mapping (and the backing file.)
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;
+};
+
+//!\brief max_heap_t that pages to a memory-mapped file, blocked so that each VM page holds whole subtrees.
+template <
+    typename t_item_t
+    , std::size_t t_arity = 2
+    , typename t_sift_policy_t = top_down_sift_t
+    , typename t_layout_t = page_blocked_layout_t<t_item_t, t_arity>
+>
+using mmap_max_heap_t = heap_t<
+    t_item_t
+    , mmap_vector_t<t_item_t>
+    , max_heapify_t<t_item_t*, t_arity, t_sift_policy_t, t_layout_t>
+>;
+
+//!\brief min_heap_t that pages to a memory-mapped file, blocked so that each VM page holds whole subtrees.
+template <
+    typename t_item_t
+    , std::size_t t_arity = 2
+    , typename t_sift_policy_t = top_down_sift_t
+    , typename t_layout_t = page_blocked_layout_t<t_item_t, t_arity>
+>
+using mmap_min_heap_t = heap_t<
+    t_item_t
+    , mmap_vector_t<t_item_t>
+    , min_heapify_t<t_item_t*, t_arity, t_sift_policy_t, t_layout_t>
+>;
+
+#endif // #if defined(__unix__) || defined(__APPLE__)
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+/*!
+    \brief Header of a heap snapshot: a heap's array, as is, preceded by this header.
+
+    The items are stored as raw bytes in native byte order, so a snapshot is only
+    read back by a heap of the same type (checked as far as the tags below tell)
+    on the same platform.  The header is 64 bytes, which keeps the items aligned
+    in a mapped snapshot (see map_heap_snapshot().)
+*/
+struct heap_snapshot_header_t
+{
+    static constexpr std::array<char, 8> file_magic = {{'H', 'E', 'A', 'P', 'S', 'N', 'A', 'P'}};
+    static constexpr std::uint32_t file_version = 1;
+
+    std::array<char, 8> magic = file_magic;
+    std::uint32_t version = file_version;
+    std::uint32_t item_size = 0;
+    std::uint64_t count = 0;
+    std::uint32_t arity = 0;
+    std::uint32_t layout_tag = 0; //!< See heap_snapshot_layout_tag.
+    std::uint32_t cmp_tag = 0;    //!< See heap_snapshot_cmp_tag.
+    std::uint32_t reserved = 0;
+    std::uint64_t checksum = 0;   //!< FNV-1a of the items' bytes.
+    std::array<std::uint64_t, 2> padding = {};
+};
+
+static_assert(64 == sizeof(heap_snapshot_header_t), "Snapshot items must stay 64 byte aligned");
+
+//!\brief Snapshot tag of a comparator; specialize it for other comparators (0: not checked.)
+template <typename t_cmp_op_t>
+struct heap_snapshot_cmp_tag : std::integral_constant<std::uint32_t, 0> {};
+
+template <typename t_item_t>
+struct heap_snapshot_cmp_tag<std::less<t_item_t>> : std::integral_constant<std::uint32_t, 1> {};
+
+template <typename t_item_t>
+struct heap_snapshot_cmp_tag<std::greater<t_item_t>> : std::integral_constant<std::uint32_t, 2> {};
+
+//!\brief Snapshot tag of a layout: its block height (1 for the flat layout; 0: not checked.)
+template <typename t_layout_t>
+struct heap_snapshot_layout_tag : std::integral_constant<std::uint32_t, 0> {};
+
+template <std::size_t t_arity, bool t_precise_parent>
+struct heap_snapshot_layout_tag<flat_layout_t<t_arity, t_precise_parent>> : std::integral_constant<std::uint32_t, 1> {};
+
+template <std::size_t t_arity, std::size_t t_block_height>
+struct heap_snapshot_layout_tag<blocked_layout_t<t_arity, t_block_height>>
+    : std::integral_constant<std::uint32_t, static_cast<std::uint32_t>(t_block_height)> {};
+
+//!\brief Return the 64 bit FNV-1a hash of [data, data + bytes).
+[[nodiscard]] inline std::uint64_t heap_snapshot_checksum(void const* const data, std::size_t const bytes)
+{
+    auto hash = std::uint64_t{14695981039346656037ull};
+    auto const* const first = static_cast<unsigned char const*>(data);
+    for (std::size_t idx = 0; bytes > idx; ++idx)
+    {
+        hash = (hash ^ first[idx]) * std::uint64_t{1099511628211ull};
+    }
+    return hash;
+}
+
+//!\brief Return the snapshot header of a 't_heap_t' of 'count' items (without the checksum.)
+template <typename t_heap_t>
+[[nodiscard]] heap_snapshot_header_t make_heap_snapshot_header(std::uint64_t const count)
+{
+    static_assert(std::is_trivially_copyable_v<typename t_heap_t::item_type>, "Snapshots store items as raw bytes");
+
+    auto header = heap_snapshot_header_t{};
+    header.item_size = static_cast<std::uint32_t>(sizeof(typename t_heap_t::item_type));
+    header.count = count;
+    header.arity = static_cast<std::uint32_t>(t_heap_t::arity);
+    header.layout_tag = heap_snapshot_layout_tag<typename t_heap_t::layout_type>::value;
+    header.cmp_tag = heap_snapshot_cmp_tag<typename t_heap_t::cmp_op_type>::value;
+    return header;
+}
+
+//!\brief Throw a std::runtime_error unless 'header' is that of a snapshot of a 't_heap_t'.
+template <typename t_heap_t>
+void check_heap_snapshot_header(heap_snapshot_header_t const& header)
+{
+    auto const expected = make_heap_snapshot_header<t_heap_t>(header.count);
+    if (expected.magic != header.magic || expected.version != header.version)
+    {
+        throw std::runtime_error{"heap snapshot: not a snapshot, or of another version"};
+    }
+    if (expected.item_size != header.item_size
+        || expected.arity != header.arity
+        || expected.layout_tag != header.layout_tag
+        || expected.cmp_tag != header.cmp_tag)
+    {
+        throw std::runtime_error{"heap snapshot: saved by another heap type"};
+    }
+    if (std::numeric_limits<std::size_t>::max() / sizeof(typename t_heap_t::item_type) < header.count)
+    {
+        throw std::runtime_error{"heap snapshot: item count out of range"};
+    }
+}
+
+//!\brief Return the number of bytes left in 'in', if it can tell (i.e. it is seekable.)
+inline std::optional<std::uint64_t> heap_snapshot_bytes_left(std::istream& in)
+{
+    auto const position = in.tellg();
+    if (std::istream::pos_type(-1) == position || !in.seekg(0, std::ios::end))
+    {
+        in.clear();
+        return std::nullopt;
+    }
+    auto const end = in.tellg();
+    in.seekg(position);
+    if (std::istream::pos_type(-1) == end || !in)
+    {
+        throw std::runtime_error{"heap snapshot: cannot seek"};
+    }
+    return static_cast<std::uint64_t>(end - position);
+}
+
+/*!
+    \brief Throw a std::runtime_error unless the snapshot's 'items' match the checksum in
+           their 'header' and are in the heap order of a 't_heap_t' (O(n).)
+*/
+template <typename t_heap_t, typename t_container_t>
+void verify_heap_snapshot(heap_snapshot_header_t const& header, t_container_t const& items)
+{
+    using item_type = typename t_heap_t::item_type;
+    if (header.checksum != heap_snapshot_checksum(items.data(), items.size() * sizeof(item_type)))
+    {
+        throw std::runtime_error{"heap snapshot: checksum mismatch"};
+    }
+    using layout_type = typename t_heap_t::layout_type;
+    using cmp_op_type = typename t_heap_t::cmp_op_type;
+    if (items.end() != find_heap_violation<layout_type, cmp_op_type>(items.begin(), items.end()))
+    {
+        throw std::runtime_error{"heap snapshot: heap order violated"};
+    }
+}
+
+/*!
+    \brief Write 'heap' to 'out' as a snapshot: a heap_snapshot_header_t and the heap's
+           array, as is (no sorting), so that loading it needs no heapify.
+*/
+template <typename t_heap_t>
+void save_heap_snapshot(t_heap_t const& heap, std::ostream& out)
+{
+    using item_type = typename t_heap_t::item_type;
+    auto const* const items = heap.empty() ? nullptr : std::addressof(*heap.begin());
+    auto const bytes = heap.size() * sizeof(item_type);
+    auto header = make_heap_snapshot_header<t_heap_t>(heap.size());
+    header.checksum = heap_snapshot_checksum(items, bytes);
+
+    out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    if (0 < bytes)
+    {
+        out.write(reinterpret_cast<char const*>(items), static_cast<std::streamsize>(bytes));
+    }
+    if (!out) { throw std::runtime_error{"heap snapshot: write failed"}; }
+}
+
+//!\brief Write 'heap' to the file 'path' as a snapshot (see save_heap_snapshot(heap, out).)
+template <typename t_heap_t>
+void save_heap_snapshot(t_heap_t const& heap, std::string const& path)
+{
+    auto out = std::ofstream{path, std::ios::binary | std::ios::trunc};
+    if (!out) { throw std::runtime_error{"heap snapshot: cannot create " + path}; }
+    save_heap_snapshot(heap, out);
+    out.close();
+    if (!out) { throw std::runtime_error{"heap snapshot: write failed"}; }
+}
+
+/*!
+    \brief Read a 't_heap_t' from a snapshot (see save_heap_snapshot()); the items are
+           adopted as they are, i.e. without a heapify.
+
+    With 'verify', the checksum and the heap order are checked, in O(n); the header
+    is always checked.  Throws a std::runtime_error for a snapshot that fails them.
+*/
+template <typename t_heap_t>
+[[nodiscard]] t_heap_t load_heap_snapshot(
+    std::istream& in
+    , bool const verify = true
+    , typename t_heap_t::allocator_type const& allocator = {})
+{
+    using item_type = typename t_heap_t::item_type;
+    auto header = heap_snapshot_header_t{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        throw std::runtime_error{"heap snapshot: truncated"};
+    }
+    check_heap_snapshot_header<t_heap_t>(header);
+
+    // Never trust the header's count with an allocation: check it against the stream's size, or (when that is
+    // unknown) grow the items in bounded chunks as they are actually read.
+    auto const count = static_cast<std::size_t>(header.count);
+    auto const bytes_left = heap_snapshot_bytes_left(in);
+    if (bytes_left && *bytes_left / sizeof(item_type) < count)
+    {
+        throw std::runtime_error{"heap snapshot: truncated"};
+    }
+    constexpr std::size_t chunk_items = std::max<std::size_t>(1, (std::size_t{1} << 24) / sizeof(item_type));
+    auto const max_chunk_items = bytes_left ? std::max<std::size_t>(1, count) : chunk_items;
+
+    typename t_heap_t::container_t items(allocator);
+    while (count > items.size())
+    {
+        auto const read_items = std::min(count - items.size(), max_chunk_items);
+        auto const offset = items.size();
+        items.resize(offset + read_items);
+        auto const bytes = static_cast<std::streamsize>(read_items * sizeof(item_type));
+        if (!in.read(reinterpret_cast<char*>(items.data() + offset), bytes))
+        {
+            throw std::runtime_error{"heap snapshot: truncated"};
+        }
+    }
+    if (verify)
+    {
+        verify_heap_snapshot<t_heap_t>(header, items);
+    }
+    return t_heap_t{heap_ordered, std::move(items)};
+}
+
+//!\brief Read a 't_heap_t' from the snapshot file 'path' (see load_heap_snapshot(in, ...).)
+template <typename t_heap_t>
+[[nodiscard]] t_heap_t load_heap_snapshot(
+    std::string const& path
+    , bool const verify = true
+    , typename t_heap_t::allocator_type const& allocator = {})
+{
+    auto in = std::ifstream{path, std::ios::binary};
+    if (!in) { throw std::runtime_error{"heap snapshot: cannot open " + path}; }
+    return load_heap_snapshot<t_heap_t>(in, verify, allocator);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+/*!
+    \brief Map the snapshot file 'path' as the storage of a heap with an mmap_vector_t
+           container (e.g. mmap_max_heap_t): no heapify and no copy of the items.
+
+    The file is mapped copy-on-write, so it is not changed by the heap, and its pages
+    are only read as they are touched; unless 'verify' (see load_heap_snapshot()), which
+    reads them all once.
+*/
+template <typename t_heap_t>
+[[nodiscard]] t_heap_t map_heap_snapshot(std::string const& path, bool const verify = true, mmap_storage_t storage = {})
+{
+    using container_type = typename t_heap_t::container_t;
+    static_assert(
+        std::is_same_v<mmap_vector_t<typename t_heap_t::item_type>, container_type>
+        , "Only an mmap_vector_t container can map a snapshot");
+
+    auto header = heap_snapshot_header_t{};
+    auto in = std::ifstream{path, std::ios::binary};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        throw std::runtime_error{"heap snapshot: cannot read " + path};
+    }
+    check_heap_snapshot_header<t_heap_t>(header);
+    auto const bytes_left = heap_snapshot_bytes_left(in);
+    if (!bytes_left || *bytes_left / sizeof(typename t_heap_t::item_type) < header.count)
+    {
+        throw std::runtime_error{"heap snapshot: truncated"}; // Mapping past the end of the file would fault.
+    }
+    in.close();
+
+    auto items = container_type::map_file(
+        path
+        , sizeof(header)
+        , static_cast<std::size_t>(header.count)
+        , std::move(storage));
+    if (verify)
+    {
+        verify_heap_snapshot<t_heap_t>(header, items);
+    }
+    return t_heap_t{heap_ordered, std::move(items)};
+}
+
+#endif // #if defined(__unix__) || defined(__APPLE__)
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+/*!
+    \brief Inline storage of up to 't_capacity' items for static_heap_t.
+
+    Items are constructed in place in an aligned buffer and destroyed with the
+    storage.  The specialization for trivial items simply holds an array, so the
+    storage (and with it static_heap_t) is a literal type for them.
+*/
+template <typename t_item_t, std::size_t t_capacity, bool t_is_trivial = std::is_trivial_v<t_item_t>>
+class static_heap_storage_t
+{
+public:
+    using item_type = t_item_t;
+
+    static_heap_storage_t() = default;
+    static_heap_storage_t(static_heap_storage_t const& other) { append(other.data(), other.data() + other.size_); }
+    static_heap_storage_t(static_heap_storage_t&& other) noexcept(std::is_nothrow_move_constructible_v<item_type>)
+    {
+        append(std::make_move_iterator(other.data()), std::make_move_iterator(other.data() + other.size_));
+        other.clear();
+    }
+
+    static_heap_storage_t& operator=(static_heap_storage_t const& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            append(other.data(), other.data() + other.size_);
+        }
+        return *this;
+    }
+
+    static_heap_storage_t& operator=(static_heap_storage_t&& other)
+        noexcept(std::is_nothrow_move_constructible_v<item_type>)
+    {
+        if (this != &other)
+        {
+            clear();
+            append(std::make_move_iterator(other.data()), std::make_move_iterator(other.data() + other.size_));
+            other.clear();
+        }
+        return *this;
+    }
+
+    ~static_heap_storage_t() { clear(); }
+
+    [[nodiscard]] item_type* data() { return std::launder(reinterpret_cast<item_type*>(slots_)); }
+    [[nodiscard]] item_type const* data() const { return std::launder(reinterpret_cast<item_type const*>(slots_)); }
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+    template <typename... t_args_t>
+    void emplace_back(t_args_t&&... args)
+    {
+        new (&slots_[size_]) item_type(std::forward<t_args_t>(args)...);
+        ++size_;
+    }
+
+    void pop_back()
+    {
+        --size_;
+        data()[size_].~item_type();
+    }
+
+    void clear()
+    {
+        while (0 < size_)
+        {
+            pop_back();
+        }
+    }
+
+private:
+    template<typename I>
+    void append(I first, I last)
+    {
+        for (; last != first; ++first)
+        {
+            emplace_back(*first);
+        }
+    }
+
+    struct alignas(item_type) slot_type
+    {
+        unsigned char bytes[sizeof(item_type)];
+    };
+
+    slot_type slots_[t_capacity];
+    std::size_t size_ = 0;
+};
+
+template <typename t_item_t, std::size_t t_capacity>
+class static_heap_storage_t<t_item_t, t_capacity, true>
+{
+public:
+    using item_type = t_item_t;
+
+    [[nodiscard]] constexpr item_type* data() { return items_; }
+    [[nodiscard]] constexpr item_type const* data() const { return items_; }
+    [[nodiscard]] constexpr std::size_t size() const { return size_; }
+
+    template <typename... t_args_t>
+    constexpr void emplace_back(t_args_t&&... args)
+    {
+        items_[size_] = item_type(std::forward<t_args_t>(args)...);
+        ++size_;
+    }
+
+    constexpr void pop_back() { --size_; }
+    constexpr void clear() { size_ = 0; }
+
+private:
+    item_type items_[t_capacity]{}; //!< Value initialized, as constant expressions require.
+    std::size_t size_ = 0;
+};
+
+/*!
+    \brief Fixed capacity heap of at most 't_capacity' items, stored inline (it never allocates.)
+
+    Items live in an aligned buffer inside the object, constructed in place as they
+    are pushed, and are ordered by the same heapify kernels as heap_t (on raw
+    pointers.)  try_push() reports a full heap by returning false; push() throws
+    std::out_of_range instead.  For trivial items all operations are constexpr, so
+    e.g. a priority table can be heapified or drained at compile time.
+*/
+template <
+    typename t_item_t
+    , std::size_t t_capacity
+    , typename t_cmp_op_t = std::greater<t_item_t>
+    , std::size_t t_arity = 2
+    , typename t_sift_policy_t = top_down_sift_t
+>
+class static_heap_t
+{
+public:
+    using item_type = t_item_t;
+    using cmp_op_type = t_cmp_op_t;
+    using iterator = item_type*;
+    using const_iterator = item_type const*;
+    using heapify_type = heapify_t<iterator, cmp_op_type, t_arity, t_sift_policy_t>;
+    using heapify_up_type = typename heapify_type::heapify_up_type;
+    using heapify_down_type = typename heapify_type::heapify_down_type;
+    using sift_policy_type = t_sift_policy_t;
+
+    static constexpr std::size_t arity = t_arity;
+
+    static_heap_t() = default;
+
+    //!\brief Initialize from begin/end iterator pair; throws std::out_of_range if the items do not fit.
+    template<typename I>
+    constexpr static_heap_t(I begin, I end)
+    {
+        for (; end != begin; ++begin)
+        {
+            if (full()) { throw std::out_of_range{"full"}; }
+            storage_.emplace_back(*begin);
+        }
+        heapify_type{}(this->begin(), this->end());
+    }
+
+    [[nodiscard]] constexpr iterator begin() { return storage_.data(); }
+    [[nodiscard]] constexpr iterator end() { return begin() + size(); }
+
+    [[nodiscard]] constexpr const_iterator begin() const { return storage_.data(); }
+    [[nodiscard]] constexpr const_iterator end() const { return begin() + size(); }
+
+    [[nodiscard]] constexpr std::size_t size() const { return storage_.size(); }
+    [[nodiscard]] constexpr bool empty() const { return 0 == size(); }
+    [[nodiscard]] constexpr bool full() const { return t_capacity == size(); }
+    [[nodiscard]] static constexpr std::size_t capacity() { return t_capacity; }
+
+    [[nodiscard]] constexpr item_type const& operator[](std::size_t idx) const { return begin()[idx]; }
+
+    //!\brief Return the head element of the heap.
+    [[nodiscard]] constexpr item_type const& top() const
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        return *begin();
+    }
+
+    //!\brief Remove the head element from the heap and return it.
+    [[nodiscard]] constexpr item_type pop_value()
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        auto result = std::move(*begin());
+        pop();
+        return result;
+    }
+
+    //!\brief Remove the head element from the heap.
+    constexpr void pop()
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        auto value = std::move(*(end() - 1));
+        storage_.pop_back();
+        if (!empty())
+        {
+            // The root is the hole; heapify the (former) last item down from it.
+            heapify_down_type{}(begin(), end(), begin(), std::move(value));
+        }
+    }
+
+    //!\brief Add an element to the heap unless it is full; return false if it is.
+    [[nodiscard]] constexpr bool try_push(item_type value)
+    {
+        if (full())
+        {
+            return false;
+        }
+
+        storage_.emplace_back(std::move(value));
+        heapify_up_type{}(begin(), end() - 1);
+        return true;
+    }
+
+    //!\brief Add an element to the heap; throws std::out_of_range if it is full.
+    constexpr static_heap_t& push(item_type value)
+    {
+        if (!try_push(std::move(value))) { throw std::out_of_range{"full"}; }
+        return *this;
+    }
+
+    //!\brief Remove all elements from the heap.
+    constexpr void clear() { storage_.clear(); }
+
+private:
+    static_heap_storage_t<item_type, t_capacity> storage_; //!< Destroys the items (also if a constructor throws.)
+};
+
+template <
+    typename t_item_t
+    , std::size_t t_capacity
+    , std::size_t t_arity = 2
+    , typename t_sift_policy_t = top_down_sift_t
+>
+using static_max_heap_t = static_heap_t<t_item_t, t_capacity, std::greater<t_item_t>, t_arity, t_sift_policy_t>;
+
+template <
+    typename t_item_t
+    , std::size_t t_capacity
+    , std::size_t t_arity = 2
+    , typename t_sift_policy_t = top_down_sift_t
+>
+using static_min_heap_t = static_heap_t<t_item_t, t_capacity, std::less<t_item_t>, t_arity, t_sift_policy_t>;
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+/*!
+    \brief Addressable heap: push() returns a stable handle that can later be used to
+           update (increase/decrease key) or erase its item in O(log(n)) time.
+
+    Each heap position stores the item together with its handle, and a handle ->
+    position map is kept current by the heapify kernels through their slot observer.
+    A handle remains valid until its item is popped or erased, after which it may
+    be reused by a later push().
+*/
+template <
+    typename t_item_t
+    , typename t_cmp_op_t = std::greater<t_item_t>
+    , std::size_t t_arity = 2
+    , typename t_sift_policy_t = top_down_sift_t
+>
+class indexed_heap_t
+{
+public:
+    using item_type = t_item_t;
+    using cmp_op_type = t_cmp_op_t;
+    using handle_type = std::size_t;
+
+    static constexpr std::size_t arity = t_arity;
+
+private:
+    struct entry_type
+    {
+        item_type item;
+        handle_type handle;
+    };
+
+    using container_t = std::vector<entry_type>;
+    using iterator = typename container_t::iterator;
+
+    struct entry_cmp_op_type
+    {
+        bool operator()(entry_type const& lhs, entry_type const& rhs) const
+        {
+            return cmp_op_type{}(lhs.item, rhs.item);
+        }
+    };
+
+    //!\brief Record the new position of every entry the heapify kernels store.
+    struct position_observer_type
+    {
+        std::vector<std::size_t>* positions = nullptr;
+
+        void operator()(iterator const& begin, iterator const& slot) const
+        {
+            (*positions)[slot->handle] = static_cast<std::size_t>(slot - begin);
+        }
+    };
+
+    using layout_type = flat_layout_t<t_arity>;
+    using heapify_up_type = heapify_up_t<
+        iterator
+        , entry_cmp_op_type
+        , t_arity
+        , layout_type
+        , position_observer_type
+        , null_stats_t
+        , t_sift_policy_t
+    >;
+    using heapify_down_type = heapify_down_t<
+        iterator
+        , entry_cmp_op_type
+        , t_arity
+        , t_sift_policy_t
+        , layout_type
+        , position_observer_type
+    >;
+
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+public:
+    indexed_heap_t() = default;
+
+    [[nodiscard]] std::size_t size() const { return array_.size(); }
+    [[nodiscard]] bool empty() const { return array_.empty(); }
+
+    //!\brief Return true if 'handle' refers to an item that is (still) in the heap.
+    [[nodiscard]] bool contains(handle_type const handle) const
+    {
+        return positions_.size() > handle && npos != positions_[handle];
+    }
+
+    //!\brief Return the item referred to by 'handle'.
+    [[nodiscard]] item_type const& operator[](handle_type const handle) const
+    {
+        return array_[position(handle)].item;
+    }
+
+    //!\brief Return the head element of the heap.
+    [[nodiscard]] item_type const& top() const
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        return array_[0].item;
+    }
+
+    //!\brief Return the handle of the head element of the heap.
+    [[nodiscard]] handle_type top_handle() const
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        return array_[0].handle;
+    }
+
+    //!\brief Remove the head element from the heap and return it.
+    [[nodiscard]] item_type pop_value()
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        auto result = std::move(array_[0].item);
+        remove_at(0);
+        return result;
+    }
+
+    //!\brief Remove the head element from the heap.
+    void pop()
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        remove_at(0);
+    }
+
+    //!\brief Add an element to the heap and return its handle.
+    handle_type push(item_type value)
+    {
+        auto const handle = acquire_handle();
+        array_.emplace_back(entry_type{std::move(value), handle});
+        auto value_entry = std::move(array_.back());
+        heapify_up_type{observer()}(array_.begin(), array_.end() - 1, std::move(value_entry));
+        return handle;
+    }
+
+    //!\brief Change the item referred to by 'handle' (increase or decrease its key.)
+    void update(handle_type const handle, item_type value)
+    {
+        auto const hole = array_.begin() + static_cast<std::ptrdiff_t>(position(handle));
+        auto const move_value_up_tree = cmp_op_type{}(value, hole->item);
+        auto value_entry = entry_type{std::move(value), handle};
+        if (move_value_up_tree)
+        {
+            heapify_up_type{observer()}(array_.begin(), hole, std::move(value_entry));
+        }
+        else
+        {
+            heapify_down_type{observer()}(array_.begin(), array_.end(), hole, std::move(value_entry));
+        }
+    }
+
+    //!\brief Remove the item referred to by 'handle' from the heap.
+    void erase(handle_type const handle)
+    {
+        remove_at(position(handle));
+    }
+
+private:
+    [[nodiscard]] std::size_t position(handle_type const handle) const
+    {
+        if (!contains(handle)) { throw std::out_of_range{"invalid handle"}; }
+        return positions_[handle];
+    }
+
+    //!\brief Return an observer bound to this heap's position map (never stored, so copies stay independent.)
+    [[nodiscard]] position_observer_type observer() { return position_observer_type{&positions_}; }
+
+    handle_type acquire_handle()
+    {
+        if (free_handles_.empty())
+        {
+            positions_.emplace_back(npos);
+            return positions_.size() - 1;
+        }
+
+        auto const handle = free_handles_.back();
+        free_handles_.pop_back();
+        return handle;
+    }
+
+    //!\brief Move the last item into the hole at 'pos' and heapify it up or down from there.
+    void remove_at(std::size_t const pos)
+    {
+        auto const hole = array_.begin() + static_cast<std::ptrdiff_t>(pos);
+        positions_[hole->handle] = npos;
+        free_handles_.emplace_back(hole->handle);
+
+        auto last_entry = std::move(array_.back());
+        array_.pop_back();
+        if (size() == pos)
+        {
+            return; // The last item was removed.
+        }
+
+        auto const move_value_up_tree = 0 != pos && cmp_op_type{}(last_entry.item, hole->item);
+        if (move_value_up_tree)
+        {
+            heapify_up_type{observer()}(array_.begin(), hole, std::move(last_entry));
+        }
+        else
+        {
+            heapify_down_type{observer()}(array_.begin(), array_.end(), hole, std::move(last_entry));
+        }
+    }
+
+    container_t array_;
+    std::vector<std::size_t> positions_; //!< handle -> position in 'array_' ('npos' when free.)
+    std::vector<handle_type> free_handles_;
+};
+
+template <typename t_item_t, std::size_t t_arity = 2, typename t_sift_policy_t = top_down_sift_t>
+using indexed_max_heap_t = indexed_heap_t<t_item_t, std::greater<t_item_t>, t_arity, t_sift_policy_t>;
+
+template <typename t_item_t, std::size_t t_arity = 2, typename t_sift_policy_t = top_down_sift_t>
+using indexed_min_heap_t = indexed_heap_t<t_item_t, std::less<t_item_t>, t_arity, t_sift_policy_t>;
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!\brief Handle of a timer_queue_t timer; it goes stale once the timer expires or is cancelled.
+struct timer_handle_t
+{
+    std::size_t slot = std::numeric_limits<std::size_t>::max(); //!< Handle of the timer in the indexed heap.
+    std::uint64_t id = 0;                                       //!< Tells a reused 'slot' apart from this timer.
+
+    [[nodiscard]] friend bool operator==(timer_handle_t const& lhs, timer_handle_t const& rhs)
+    {
+        return lhs.slot == rhs.slot && lhs.id == rhs.id;
+    }
+    [[nodiscard]] friend bool operator!=(timer_handle_t const& lhs, timer_handle_t const& rhs)
+    {
+        return !(lhs == rhs);
+    }
+};
+
+/*!
+    \brief Timer queue: schedule, cancel or reschedule payloads by deadline, and expire
+           all the due ones in one batch.
+
+    The deadlines are kept in an indexed min heap (so cancel() and reschedule() are
+    O(log(n))), the payloads beside it, out of the way of the sifts.  Timers with equal
+    deadlines expire in the order they were (re)scheduled.
+
+    expire_until(now, callback) takes the caller's 'now' (the queue never reads a clock)
+    and first removes every timer due at 'now', then calls 'callback' with each of their
+    payloads.  So a callback may schedule, cancel or reschedule freely: a timer it
+    schedules waits for the next batch (even when it is already due), and cancelling a
+    timer of the current batch has no effect (its handle is already stale.)  If a
+    callback throws, the rest of its batch is dropped.
+*/
+template <
+    typename t_payload_t
+    , typename t_time_t = std::chrono::steady_clock::time_point
+    , std::size_t t_arity = 2
+>
+class timer_queue_t
+{
+public:
+    using payload_type = t_payload_t;
+    using time_type = t_time_t;
+    using handle_type = timer_handle_t;
+
+    static constexpr std::size_t arity = t_arity;
+
+private:
+    struct deadline_type
+    {
+        time_type time;
+        std::uint64_t sequence; //!< Orders equal deadlines (first scheduled, first expired.)
+    };
+
+    struct deadline_cmp_op_type
+    {
+        bool operator()(deadline_type const& lhs, deadline_type const& rhs) const
+        {
+            return lhs.time < rhs.time || (!(rhs.time < lhs.time) && lhs.sequence < rhs.sequence);
+        }
+    };
+
+    struct slot_type
+    {
+        std::uint64_t id = 0;
+        std::optional<payload_type> payload;
+    };
+
+    using heap_type = indexed_heap_t<deadline_type, deadline_cmp_op_type, t_arity>;
+
+public:
+    timer_queue_t() = default;
+
+    [[nodiscard]] std::size_t size() const { return heap_.size(); }
+    [[nodiscard]] bool empty() const { return heap_.empty(); }
+
+    //!\brief Return true if 'handle' refers to a timer that has neither expired nor been cancelled.
+    [[nodiscard]] bool contains(handle_type const& handle) const
+    {
+        return heap_.contains(handle.slot) && slots_[handle.slot].id == handle.id;
+    }
+
+    //!\brief Return the deadline of the timer referred to by 'handle'.
+    [[nodiscard]] time_type const& deadline(handle_type const& handle) const
+    {
+        if (!contains(handle)) { throw std::out_of_range{"invalid handle"}; }
+        return heap_[handle.slot].time;
+    }
+
+    //!\brief Return the earliest deadline (e.g. to bound an event loop's poll timeout.)
+    [[nodiscard]] time_type const& next_deadline() const
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        return heap_.top().time;
+    }
+
+    //!\brief Schedule 'payload' to expire at 'deadline' and return the handle of its timer.
+    handle_type schedule(time_type deadline, payload_type payload)
+    {
+        auto const id = next_sequence_;
+        auto const slot = heap_.push(deadline_type{std::move(deadline), next_sequence_++});
+        if (slots_.size() <= slot)
+        {
+            slots_.resize(slot + 1);
+        }
+        slots_[slot].id = id;
+        slots_[slot].payload.emplace(std::move(payload));
+        return handle_type{slot, id};
+    }
+
+    //!\brief Cancel the timer referred to by 'handle'; return false if it has already expired or been cancelled.
+    bool cancel(handle_type const& handle)
+    {
+        if (!contains(handle))
+        {
+            return false;
+        }
+
+        heap_.erase(handle.slot);
+        slots_[handle.slot].payload.reset();
+        return true;
+    }
+
+    //!\brief Move the timer referred to by 'handle' to 'deadline' (earlier or later.)
+    void reschedule(handle_type const& handle, time_type deadline)
+    {
+        if (!contains(handle)) { throw std::out_of_range{"invalid handle"}; }
+        heap_.update(handle.slot, deadline_type{std::move(deadline), next_sequence_++});
+    }
+
+    /*!
+        \brief Expire every timer whose deadline is not after 'now': remove them all, then
+               call 'callback' with each of their payloads, in deadline order.
+
+        \return The number of timers that expired.
+    */
+    template <typename t_callback_t>
+    std::size_t expire_until(time_type const& now, t_callback_t&& callback)
+    {
+        // Take the batch buffer, so a callback that expires timers (re-entrantly) gets one of its own.
+        auto batch = std::move(batch_);
+        batch.clear();
+        while (!heap_.empty() && !(now < heap_.top().time))
+        {
+            auto& slot = slots_[heap_.top_handle()];
+            batch.emplace_back(std::move(*slot.payload));
+            slot.payload.reset();
+            heap_.pop();
+        }
+
+        for (auto& payload : batch)
+        {
+            std::invoke(callback, std::move(payload));
+        }
+
+        auto const expired = batch.size();
+        batch.clear();
+        batch_ = std::move(batch);
+        return expired;
+    }
+
+private:
+    heap_type heap_;
+    std::vector<slot_type> slots_;    //!< Heap handle -> id and payload of its timer.
+    std::vector<payload_type> batch_; //!< Reused by expire_until() (so batches don't allocate once warm.)
+    std::uint64_t next_sequence_ = 1;
+};
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+//!\brief Timer queue of suspended coroutines to run a single threaded event loop with.
+template <typename t_time_t = std::chrono::steady_clock::time_point, std::size_t t_arity = 2>
+using coroutine_timer_queue_t = timer_queue_t<std::coroutine_handle<>, t_time_t, t_arity>;
+
+/*!
+    \brief Awaitable that suspends the awaiting coroutine in 'queue' until 'deadline'.
+
+    The coroutine is resumed by whoever expires its timer, e.g. resume_until(queue, now.)
+    It always suspends (the queue never reads a clock), and a coroutine must not be
+    destroyed while it is suspended in the queue.
+*/
+template <typename t_time_t, std::size_t t_arity>
+[[nodiscard]] auto sleep_until(
+    coroutine_timer_queue_t<t_time_t, t_arity>& queue
+    , typename coroutine_timer_queue_t<t_time_t, t_arity>::time_type deadline)
+{
+    struct awaiter_type
+    {
+        coroutine_timer_queue_t<t_time_t, t_arity>* queue;
+        t_time_t deadline;
+
+        [[nodiscard]] bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> const coroutine) { queue->schedule(deadline, coroutine); }
+        void await_resume() const noexcept {}
+    };
+    return awaiter_type{&queue, std::move(deadline)};
+}
+
+//!\brief Resume every coroutine in 'queue' that sleeps until no later than 'now'; return how many were resumed.
+template <typename t_time_t, std::size_t t_arity>
+std::size_t resume_until(
+    coroutine_timer_queue_t<t_time_t, t_arity>& queue
+    , typename coroutine_timer_queue_t<t_time_t, t_arity>::time_type const& now)
+{
+    return queue.expire_until(now, [](std::coroutine_handle<> const coroutine){ coroutine.resume(); });
+}
+
+#endif // #if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!\brief Type of the key that 't_key_of_t' extracts from a 't_item_t'.
+template <typename t_item_t, typename t_key_of_t>
+using key_of_result_t = std::decay_t<std::invoke_result_t<t_key_of_t, t_item_t const&>>;
+
+/*!
+    \brief Structure-of-arrays heap: the heap order is kept in a dense array of
+           (key, payload slot) entries while the items (payloads) never move.
+
+    Each item's key is extracted once (by 't_key_of_t') when it is pushed, so
+    heapifying only ever touches the small entries, e.g. a 4 byte priority and
+    its slot index instead of a 128 byte record.  Items are moved only when
+    they are pushed and when they are popped.
+*/
+template <
+    typename t_item_t
+    , typename t_key_of_t
+    , typename t_cmp_op_t = std::greater<key_of_result_t<t_item_t, t_key_of_t>>
+    , std::size_t t_arity = 2
+    , typename t_sift_policy_t = top_down_sift_t
+>
+class soa_heap_t
+{
+public:
+    using item_type = t_item_t;
+    using key_of_type = t_key_of_t;
+    using key_type = key_of_result_t<t_item_t, t_key_of_t>;
+    using cmp_op_type = t_cmp_op_t;
+
+    static constexpr std::size_t arity = t_arity;
+
+private:
+    struct entry_type
+    {
+        key_type key;
+        std::size_t slot; //!< Index of the item in 'payloads_'.
+    };
+
+    using container_t = std::vector<entry_type>;
+    using iterator = typename container_t::iterator;
+
+    struct entry_cmp_op_type
+    {
+        bool operator()(entry_type const& lhs, entry_type const& rhs) const
+        {
+            return cmp_op_type{}(lhs.key, rhs.key);
+        }
+    };
+
+    using heapify_type = heapify_t<iterator, entry_cmp_op_type, t_arity, t_sift_policy_t>;
+    using heapify_up_type = typename heapify_type::heapify_up_type;
+    using heapify_down_type = typename heapify_type::heapify_down_type;
+
+public:
+    soa_heap_t() = default;
+
+    //!\brief Initialize from begin/end iterator pair.
+    template<typename I>
+    soa_heap_t(I begin, I end)
+        : payloads_(begin, end)
+    {
+        array_.reserve(payloads_.size());
+        for (std::size_t slot = 0; payloads_.size() > slot; ++slot)
+        {
+            array_.emplace_back(entry_type{key_of_type{}(payloads_[slot]), slot});
+        }
+        heapify_type{}(array_.begin(), array_.end());
+    }
+
+    [[nodiscard]] std::size_t size() const { return array_.size(); }
+    [[nodiscard]] bool empty() const { return array_.empty(); }
+
+    //!\brief Return the head element of the heap.
+    [[nodiscard]] item_type const& top() const
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        return payloads_[array_[0].slot];
+    }
+
+    //!\brief Return the key of the head element of the heap.
+    [[nodiscard]] key_type const& top_key() const
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        return array_[0].key;
+    }
+
+    //!\brief Remove the head element from the heap and return it.
+    [[nodiscard]] item_type pop_value()
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        auto result = std::move(payloads_[array_[0].slot]);
+        pop();
+        return result;
+    }
+
+    //!\brief Remove the head element from the heap.
+    void pop()
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        release_slot(array_[0].slot);
+        auto value = std::move(array_.back());
+        array_.pop_back();
+        if (!empty())
+        {
+            // The root is the hole; heapify the (former) last entry down from it.
+            heapify_down_type{}(array_.begin(), array_.end(), array_.begin(), std::move(value));
+        }
+    }
+
+    //!\brief Add an element to the heap.
+    soa_heap_t& push(item_type value)
+    {
+        auto value_entry = entry_type{key_of_type{}(value), acquire_slot(std::move(value))};
+        array_.emplace_back(value_entry);
+        heapify_up_type{}(array_.begin(), array_.end() - 1, std::move(value_entry));
+
+        return *this;
+    }
+
+private:
+    //!\brief Store 'value' in a free payload slot and return the slot's index.
+    std::size_t acquire_slot(item_type&& value)
+    {
+        if (free_slots_.empty())
+        {
+            payloads_.emplace_back(std::move(value));
+            return payloads_.size() - 1;
+        }
+
+        auto const slot = free_slots_.back();
+        free_slots_.pop_back();
+        payloads_[slot] = std::move(value);
+        return slot;
+    }
+
+    void release_slot(std::size_t const slot)
+    {
+        if (payloads_.size() - 1 == slot)
+        {
+            payloads_.pop_back();
+        }
+        else
+        {
+            free_slots_.emplace_back(slot);
+        }
+    }
+
+    container_t array_; //!< Heap ordered (key, slot) entries.
+    std::vector<item_type> payloads_; //!< Items, indexed by slot; they do not move while in the heap.
+    std::vector<std::size_t> free_slots_;
+};
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+/*!
+    \brief Min-max heap: a double-ended priority queue in a single flat array.
+
+    The levels alternate: every item on an even (min) level, starting with the
+    root, is first in 't_cmp_op_t' order among its descendants, and every item
+    on an odd (max) level is last among them.  So min() is the root and max()
+    is the last of the root's children, both O(1), while push(), pop_min() and
+    pop_max() sift over every other level, O(log(n)).  One array (and one set
+    of moves) replaces a max_heap_t and a min_heap_t kept side by side; the
+    container is pluggable as for heap_t (e.g. std::pmr::vector for an arena.)
+    For large records, order light entries instead, e.g. a (key, slot) pair
+    with a comparator on the key, as soa_heap_t does.
+*/
+template <
+    typename t_item_t
+    , typename t_container_t = std::vector<t_item_t>
+    , typename t_cmp_op_t = std::less<t_item_t>
+>
+class min_max_heap_t
+{
+public:
+    using item_type = t_item_t;
+    using container_t = t_container_t;
+    using allocator_type = typename container_t::allocator_type;
+    using const_iterator = typename container_t::const_iterator;
+    using cmp_op_type = t_cmp_op_t;
+
+    min_max_heap_t() = default;
+
+    //!\brief Initialize an empty heap whose storage comes from 'allocator' (e.g. a std::pmr arena.)
+    explicit min_max_heap_t(allocator_type const& allocator)
+        : array_(allocator)
+    {
+        // Do nothing.
+    }
+
+    //!\brief Initialize from begin/end iterator pair (in O(n), bottom up like heapify_t.)
+    template<typename I>
+    min_max_heap_t(I begin, I end)
+        : array_(begin, end)
+    {
+        heapify();
+    }
+
+    //!\brief Initialize from begin/end iterator pair, with storage from 'allocator'.
+    template<typename I>
+    min_max_heap_t(I begin, I end, allocator_type const& allocator)
+        : array_(begin, end, allocator)
+    {
+        heapify();
+    }
+
+    //!\brief Initialize from array.
+    template<typename A, std::size_t S>
+    min_max_heap_t(A const (&ary)[S])
+        : min_max_heap_t{ary, ary + S}
+    {
+        // Do nothing.
+    }
+
+    [[nodiscard]] const_iterator begin() const { return array_.begin(); }
+    [[nodiscard]] const_iterator end() const { return array_.end(); }
+
+    [[nodiscard]] std::size_t size() const { return array_.size(); }
+    [[nodiscard]] bool empty() const { return array_.empty(); }
+    [[nodiscard]] std::size_t capacity() const { return array_.capacity(); }
+    [[nodiscard]] allocator_type get_allocator() const { return array_.get_allocator(); }
+
+    //!\brief Pre-size the storage for 'count' elements, so pushes do not reallocate.
+    void reserve(std::size_t const count) { array_.reserve(count); }
+
+    //!\brief Return the first element in 't_cmp_op_t' order.
+    [[nodiscard]] item_type const& min() const
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        return array_[0];
+    }
+
+    //!\brief Return the last element in 't_cmp_op_t' order.
+    [[nodiscard]] item_type const& max() const
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        return array_[max_idx()];
+    }
+
+    //!\brief Remove the first element and return it.
+    [[nodiscard]] item_type pop_min_value()
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        auto result = std::move(array_[0]);
+        erase_at(0);
+        return result;
+    }
+
+    //!\brief Remove the last element and return it.
+    [[nodiscard]] item_type pop_max_value()
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        auto const idx = max_idx();
+        auto result = std::move(array_[idx]);
+        erase_at(idx);
+        return result;
+    }
+
+    //!\brief Remove the first element.
+    void pop_min()
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        erase_at(0);
+    }
+
+    //!\brief Remove the last element.
+    void pop_max()
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        erase_at(max_idx());
+    }
+
+    //!\brief Construct an element in place from 'args' and add it to the heap.
+    template <typename... t_args_t>
+    min_max_heap_t& emplace(t_args_t&&... args)
+    {
+        array_.emplace_back(std::forward<t_args_t>(args)...);
+        auto value = std::move(array_.back());
+        sift_up(size() - 1, std::move(value));
+
+        return *this;
+    }
+
+    //!\brief Add an element to the heap.
+    min_max_heap_t& push(item_type value) { return emplace(std::move(value)); }
+
+private:
+    //!\brief Return true if 'idx' is on a min level (the root's level is 0.)
+    [[nodiscard]] static constexpr bool is_min_level(std::size_t const idx)
+    {
+        auto is_min = true;
+        for (auto n = idx + 1; 1 < n; n >>= 1)
+        {
+            is_min = !is_min;
+        }
+        return is_min;
+    }
+
+    //!\brief Return true if 'lhs' belongs above 'rhs' on a min (t_is_min) or max level.
+    template <bool t_is_min>
+    [[nodiscard]] static bool above(item_type const& lhs, item_type const& rhs)
+    {
+        return t_is_min ? cmp_op_type{}(lhs, rhs) : cmp_op_type{}(rhs, lhs);
+    }
+
+    //!\brief Return the index of the last element: the root, or the last of its (up to two) children.
+    [[nodiscard]] std::size_t max_idx() const
+    {
+        if (2 >= size())
+        {
+            return size() - 1;
+        }
+        return above<false>(array_[2], array_[1]) ? 2 : 1;
+    }
+
+    //!\brief Build the heap: sift down every parent, the last one first.
+    void heapify()
+    {
+        for (auto idx = size() / 2; 0 < idx--; )
+        {
+            auto value = std::move(array_[idx]);
+            sift_down(idx, std::move(value));
+        }
+    }
+
+    //!\brief Remove the element at 'idx' (the root or one of its children): fill the hole with the last element.
+    void erase_at(std::size_t const idx)
+    {
+        auto value = std::move(array_.back());
+        array_.pop_back();
+        if (size() > idx)
+        {
+            sift_down(idx, std::move(value));
+        }
+    }
+
+    //!\brief Store 'value' at the hole 'idx', or above it (a new leaf.)
+    void sift_up(std::size_t const idx, item_type value)
+    {
+        if (0 == idx)
+        {
+            array_[0] = std::move(value);
+            return;
+        }
+
+        // Past its parent, an item can only move up its own (min or max) levels.
+        auto const parent = (idx - 1) / 2;
+        if (is_min_level(idx))
+        {
+            if (above<false>(value, array_[parent]))
+            {
+                array_[idx] = std::move(array_[parent]);
+                sift_up_levels<false>(parent, std::move(value));
+            }
+            else
+            {
+                sift_up_levels<true>(idx, std::move(value));
+            }
+        }
+        else
+        {
+            if (above<true>(value, array_[parent]))
+            {
+                array_[idx] = std::move(array_[parent]);
+                sift_up_levels<true>(parent, std::move(value));
+            }
+            else
+            {
+                sift_up_levels<false>(idx, std::move(value));
+            }
+        }
+    }
+
+    //!\brief Move the hole at 'idx' up through its grandparents (on min or max levels) until 'value' fits.
+    template <bool t_is_min>
+    void sift_up_levels(std::size_t idx, item_type value)
+    {
+        while (3 <= idx) // Has a grandparent.
+        {
+            auto const grandparent = (idx - 3) / 4;
+            if (!above<t_is_min>(value, array_[grandparent]))
+            {
+                break;
+            }
+            array_[idx] = std::move(array_[grandparent]);
+            idx = grandparent;
+        }
+        array_[idx] = std::move(value);
+    }
+
+    //!\brief Store 'value' at the hole 'idx', or below it.
+    void sift_down(std::size_t const idx, item_type value)
+    {
+        if (is_min_level(idx))
+        {
+            sift_down_levels<true>(idx, std::move(value));
+        }
+        else
+        {
+            sift_down_levels<false>(idx, std::move(value));
+        }
+    }
+
+    /*!
+        \brief Move the hole at 'idx' down until 'value' fits.
+
+        The hole follows the best of its children and grandchildren; when that is a
+        grandchild, 'value' is swapped with the grandchild's parent (on the opposite
+        kind of level) if it belongs above it, and sinking continues from the grandchild.
+    */
+    template <bool t_is_min>
+    void sift_down_levels(std::size_t idx, item_type value)
+    {
+        auto const count = size();
+        while (2 * idx + 1 < count)
+        {
+            // The best of the (up to two) children and (up to four) grandchildren.
+            auto const first_child = 2 * idx + 1;
+            auto best = first_child;
+            if (count > first_child + 1 && above<t_is_min>(array_[first_child + 1], array_[best]))
+            {
+                best = first_child + 1;
+            }
+            auto const first_grandchild = 2 * first_child + 1;
+            auto const last_grandchild = std::min(first_grandchild + 4, count);
+            for (auto grandchild = first_grandchild; last_grandchild > grandchild; ++grandchild)
+            {
+                if (above<t_is_min>(array_[grandchild], array_[best])) { best = grandchild; }
+            }
+            if (!above<t_is_min>(array_[best], value))
+            {
+                break;
+            }
+
+            array_[idx] = std::move(array_[best]);
+            idx = best;
+            if (first_grandchild > best)
+            {
+                break; // A child is the opposite extreme of its own subtree, so 'value' fits in its place.
+            }
+            auto& parent = array_[(best - 1) / 2]; // On the opposite kind of level.
+            if (above<!t_is_min>(value, parent))
+            {
+                std::swap(value, parent);
+            }
+        }
+        array_[idx] = std::move(value);
+    }
+
+    container_t array_;
+};
+
+//!\brief min_max_heap_t whose storage comes from a std::pmr::memory_resource (e.g. a per request arena.)
+template <typename t_item_t, typename t_cmp_op_t = std::less<t_item_t>>
+using pmr_min_max_heap_t = min_max_heap_t<t_item_t, std::pmr::vector<t_item_t>, t_cmp_op_t>;
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!\brief Lightweight (test and test-and-set) spin lock; satisfies the standard Lockable requirements.
+class spin_lock_t
+{
+public:
+    [[nodiscard]] bool try_lock()
+    {
+        return !locked_.load(std::memory_order_relaxed) && !locked_.exchange(true, std::memory_order_acquire);
+    }
+
+    void lock()
+    {
+        while (!try_lock())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void unlock() { locked_.store(false, std::memory_order_release); }
+
+private:
+    std::atomic<bool> locked_{false};
+};
+
+/*!
+    \brief Relaxed concurrent priority queue (MultiQueue) built from sharded heap_t instances.
+
+    The queue holds c * (thread count) shards, each a heap_t with its own spin lock.
+    A push goes to a random shard and a pop removes the better of the tops of two
+    random shards, so threads rarely contend for the same lock and throughput
+    scales with the number of threads.  In exchange, the ordering is relaxed: a
+    pop returns an item that is close to, but not necessarily, the best one.
+
+    Threads access the queue through a handle_t, which also buffers up to
+    'buffer_size' pushed items (flushed to one shard in one locked push_range())
+    and popped items (taken from one shard in one locked pop_n()).  An item
+    pushed through a handle is not visible to other threads until it is flushed.
+*/
+template <typename t_item_t, typename t_heap_t = max_heap_t<t_item_t>>
+class multi_queue_t
+{
+public:
+    using heap_type = t_heap_t;
+    using item_type = typename heap_type::item_type;
+    using cmp_op_type = typename heap_type::cmp_op_type;
+
+    static_assert(std::is_same_v<item_type, t_item_t>, "The heap must hold the queue's item type.");
+
+    class handle_t;
+
+    explicit multi_queue_t(
+        std::size_t const thread_count
+        , std::size_t const shards_per_thread = 2
+        , std::size_t const buffer_size = 16
+    )
+        : shard_count_{std::max<std::size_t>(2, thread_count * shards_per_thread)}
+        , buffer_size_{std::max<std::size_t>(1, buffer_size)}
+        , shards_{std::make_unique<shard_type[]>(shard_count_)}
+    {
+        // Do nothing.
+    }
+
+    //!\brief Return a handle for one thread to push and pop through.
+    [[nodiscard]] handle_t get_handle() { return handle_t{*this, next_seed_.fetch_add(1, std::memory_order_relaxed)}; }
+
+    //!\brief Return the number of items in the shards (a snapshot; excludes items buffered in handles.)
+    [[nodiscard]] std::size_t size() const
+    {
+        std::size_t result = 0;
+        for (std::size_t idx = 0; shard_count_ > idx; ++idx)
+        {
+            result += shards_[idx].size.load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    [[nodiscard]] bool empty() const { return 0 == size(); }
+
+    [[nodiscard]] std::size_t shard_count() const { return shard_count_; }
+
+private:
+    struct alignas(64) shard_type
+    {
+        spin_lock_t lock;
+        std::atomic<std::size_t> size{0}; //!< Lets pops skip empty shards without locking them.
+        heap_type heap;
+    };
+
+    using rng_type = std::minstd_rand;
+
+    [[nodiscard]] std::size_t random_shard(rng_type& rng) const
+    {
+        return static_cast<std::size_t>(rng()) % shard_count_;
+    }
+
+    //!\brief Move all of 'items' into one (random, unlocked) shard.
+    void push_batch(rng_type& rng, std::vector<item_type>& items)
+    {
+        while (true)
+        {
+            auto& shard = shards_[random_shard(rng)];
+            if (shard.lock.try_lock())
+            {
+                std::lock_guard<spin_lock_t> const guard{shard.lock, std::adopt_lock};
+                shard.heap.push_range(std::make_move_iterator(items.begin()), std::make_move_iterator(items.end()));
+                shard.size.store(shard.heap.size(), std::memory_order_relaxed);
+                break;
+            }
+        }
+        items.clear();
+    }
+
+    //!\brief Pop up to 'buffer_size_' items from the better of two random shards into 'items'.
+    bool pop_batch(rng_type& rng, std::vector<item_type>& items)
+    {
+        for (std::size_t attempt = 0; shard_count_ > attempt; ++attempt)
+        {
+            auto* first = &shards_[random_shard(rng)];
+            auto* second = &shards_[random_shard(rng)];
+            if (0 == first->size.load(std::memory_order_relaxed))
+            {
+                std::swap(first, second);
+            }
+            if (0 == first->size.load(std::memory_order_relaxed))
+            {
+                continue; // (Probably) both empty.
+            }
+
+            if (first == second || 0 == second->size.load(std::memory_order_relaxed))
+            {
+                if (first->lock.try_lock())
+                {
+                    std::lock_guard<spin_lock_t> const guard{first->lock, std::adopt_lock};
+                    if (pop_from(*first, items))
+                    {
+                        return true;
+                    }
+                }
+                continue;
+            }
+
+            if (-1 == std::try_lock(first->lock, second->lock))
+            {
+                std::lock_guard<spin_lock_t> const first_guard{first->lock, std::adopt_lock};
+                std::lock_guard<spin_lock_t> const second_guard{second->lock, std::adopt_lock};
+                auto const prefer_second = !second->heap.empty()
+                    && (first->heap.empty() || cmp_op_type{}(second->heap[0], first->heap[0]));
+                if (pop_from(prefer_second ? *second : *first, items))
+                {
+                    return true;
+                }
+            }
+        }
+
+        // The random picks keep missing: look at every shard before reporting that the queue is empty.
+        for (std::size_t idx = 0; shard_count_ > idx; ++idx)
+        {
+            std::lock_guard<spin_lock_t> const guard{shards_[idx].lock};
+            if (pop_from(shards_[idx], items))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    //!\brief Pop up to 'buffer_size_' items from the (locked) 'shard' into 'items'.
+    bool pop_from(shard_type& shard, std::vector<item_type>& items)
+    {
+        if (shard.heap.empty())
+        {
+            return false;
+        }
+
+        shard.heap.pop_n(buffer_size_, std::back_inserter(items));
+        shard.size.store(shard.heap.size(), std::memory_order_relaxed);
+        std::reverse(items.begin(), items.end()); // The handle hands them out from the back.
+        return true;
+    }
+
+    std::size_t const shard_count_;
+    std::size_t const buffer_size_;
+    std::unique_ptr<shard_type[]> shards_;
+    std::atomic<std::uint32_t> next_seed_{1};
+};
+
+//!\brief A thread's access point to a multi_queue_t, with its own insertion and deletion buffers.
+template <typename t_item_t, typename t_heap_t>
+class multi_queue_t<t_item_t, t_heap_t>::handle_t
+{
+public:
+    handle_t(handle_t&& other) noexcept
+        : queue_{std::exchange(other.queue_, nullptr)}
+        , rng_{other.rng_}
+        , insertions_{std::move(other.insertions_)}
+        , deletions_{std::move(other.deletions_)}
+    {
+        // Do nothing.
+    }
+
+    handle_t& operator=(handle_t&&) = delete;
+    handle_t(handle_t const&) = delete;
+    handle_t& operator=(handle_t const&) = delete;
+
+    ~handle_t()
+    {
+        if (nullptr != queue_)
+        {
+            flush();
+        }
+    }
+
+    //!\brief Add an element to the queue (buffered until 'buffer_size' items are pending or flush().)
+    void push(item_type value)
+    {
+        insertions_.emplace_back(std::move(value));
+        if (queue_->buffer_size_ <= insertions_.size())
+        {
+            queue_->push_batch(rng_, insertions_);
+        }
+    }
+
+    //!\brief Remove a near-best element from the queue, or return nothing if the queue is (seen) empty.
+    [[nodiscard]] std::optional<item_type> try_pop()
+    {
+        if (deletions_.empty())
+        {
+            if (!insertions_.empty())
+            {
+                queue_->push_batch(rng_, insertions_);
+            }
+            if (!queue_->pop_batch(rng_, deletions_))
+            {
+                return std::nullopt;
+            }
+        }
+
+        auto result = std::optional<item_type>{std::move(deletions_.back())};
+        deletions_.pop_back();
+        return result;
+    }
+
+    //!\brief Make all buffered items visible to other threads again.
+    void flush()
+    {
+        if (!insertions_.empty())
+        {
+            queue_->push_batch(rng_, insertions_);
+        }
+        if (!deletions_.empty())
+        {
+            queue_->push_batch(rng_, deletions_);
+        }
+    }
+
+private:
+    friend class multi_queue_t;
+
+    handle_t(multi_queue_t& queue, std::uint32_t const seed)
+        : queue_{&queue}
+        , rng_{seed}
+    {
+        insertions_.reserve(queue.buffer_size_);
+        deletions_.reserve(queue.buffer_size_);
+    }
+
+    multi_queue_t* queue_; //!< Null once moved from.
+    rng_type rng_;
+    std::vector<item_type> insertions_;
+    std::vector<item_type> deletions_;
+};
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+/*!
+    \brief Pool of fixed size node storage, allocated 't_chunk_size' nodes at a time.
+
+    Node storage is recycled through a free list, and two pools can be spliced in
+    O(1) (all of the other pool's chunks and free nodes are taken over) so that
+    node based containers can meld without copying nodes.
+*/
+template <typename t_node_t, std::size_t t_chunk_size = 256>
+class node_pool_t
+{
+public:
+    using node_type = t_node_t;
+
+    node_pool_t() = default;
+    node_pool_t(node_pool_t const&) = delete;
+    node_pool_t& operator=(node_pool_t const&) = delete;
+
+    node_pool_t(node_pool_t&& other) noexcept { splice(other); }
+
+    node_pool_t& operator=(node_pool_t&& other) noexcept
+    {
+        release();
+        splice(other);
+        return *this;
+    }
+
+    //!\brief Release all storage; nodes that are still constructed must have been destroyed.
+    ~node_pool_t() { release(); }
+
+    template <typename... t_args_t>
+    [[nodiscard]] node_type* create(t_args_t&&... args)
+    {
+        if (nullptr == free_)
+        {
+            grow();
+        }
+
+        auto* const slot = free_;
+        free_ = slot->next_free;
+        if (nullptr == free_)
+        {
+            free_tail_ = nullptr;
+        }
+        return new (slot->storage) node_type{std::forward<t_args_t>(args)...};
+    }
+
+    void destroy(node_type* const node)
+    {
+        node->~node_type();
+        auto* const slot = new (static_cast<void*>(node)) slot_type{};
+        slot->next_free = free_;
+        free_ = slot;
+        if (nullptr == free_tail_)
+        {
+            free_tail_ = slot;
+        }
+    }
+
+    //!\brief Take over all chunks and free nodes of 'other', leaving it empty.
+    void splice(node_pool_t& other) noexcept
+    {
+        if (nullptr != other.chunks_)
+        {
+            other.chunks_tail_->next = chunks_;
+            if (nullptr == chunks_)
+            {
+                chunks_tail_ = other.chunks_tail_;
+            }
+            chunks_ = std::exchange(other.chunks_, nullptr);
+            other.chunks_tail_ = nullptr;
+        }
+        if (nullptr != other.free_)
+        {
+            other.free_tail_->next_free = free_;
+            if (nullptr == free_)
+            {
+                free_tail_ = other.free_tail_;
+            }
+            free_ = std::exchange(other.free_, nullptr);
+            other.free_tail_ = nullptr;
+        }
+    }
+
+private:
+    union slot_type
+    {
+        slot_type* next_free;
+        alignas(node_type) unsigned char storage[sizeof(node_type)];
+    };
+
+    struct chunk_type
+    {
+        chunk_type* next = nullptr;
+        slot_type slots[t_chunk_size];
+    };
+
+    void grow()
+    {
+        auto* const chunk = new chunk_type{};
+        chunk->next = chunks_;
+        chunks_ = chunk;
+        if (nullptr == chunks_tail_)
+        {
+            chunks_tail_ = chunk;
+        }
+
+        for (std::size_t idx = 0; t_chunk_size > idx; ++idx)
+        {
+            chunk->slots[idx].next_free = t_chunk_size - 1 > idx ? &chunk->slots[idx + 1] : nullptr;
+        }
+        free_ = &chunk->slots[0];
+        free_tail_ = &chunk->slots[t_chunk_size - 1];
+    }
+
+    void release() noexcept
+    {
+        while (nullptr != chunks_)
+        {
+            delete std::exchange(chunks_, chunks_->next);
+        }
+        chunks_tail_ = nullptr;
+        free_ = nullptr;
+        free_tail_ = nullptr;
+    }
+
+    chunk_type* chunks_ = nullptr;
+    chunk_type* chunks_tail_ = nullptr;
+    slot_type* free_ = nullptr;
+    slot_type* free_tail_ = nullptr;
+};
+
+/*!
+    \brief Mergeable heap: a (two pass) pairing heap with pool allocated nodes.
+
+    Offers the same push/top/pop/pop_value surface as heap_t and the update/erase by
+    handle of indexed_heap_t, plus meld(), which takes over another pairing heap in
+    O(1): the roots are linked and the other heap's node pool is spliced into this
+    one.  push() is O(1), pop(), erase() and update() are O(log(n)) amortized.
+*/
+template <typename t_item_t, typename t_cmp_op_t = std::greater<t_item_t>>
+class pairing_heap_t
+{
+private:
+    struct node_type
+    {
+        t_item_t item;
+        node_type* child = nullptr; //!< First child.
+        node_type* next = nullptr; //!< Next sibling.
+        node_type* prev = nullptr; //!< Previous sibling, or the parent of a first child.
+    };
+
+public:
+    using item_type = t_item_t;
+    using cmp_op_type = t_cmp_op_t;
+
+    //!\brief Refers to an item until the item is popped or erased.
+    class handle_type
+    {
+    public:
+        handle_type() = default;
+
+        [[nodiscard]] bool operator==(handle_type const& other) const { return node_ == other.node_; }
+        [[nodiscard]] bool operator!=(handle_type const& other) const { return node_ != other.node_; }
+
+    private:
+        friend class pairing_heap_t;
+
+        explicit handle_type(node_type* const node) : node_{node} {}
+
+        node_type* node_ = nullptr;
+    };
+
+    pairing_heap_t() = default;
+    pairing_heap_t(pairing_heap_t const&) = delete;
+    pairing_heap_t& operator=(pairing_heap_t const&) = delete;
+
+    pairing_heap_t(pairing_heap_t&& other) noexcept
+        : root_{std::exchange(other.root_, nullptr)}
+        , size_{std::exchange(other.size_, 0)}
+        , pool_{std::move(other.pool_)}
+    {
+        // Do nothing.
+    }
+
+    pairing_heap_t& operator=(pairing_heap_t&& other) noexcept
+    {
+        clear();
+        root_ = std::exchange(other.root_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        pool_ = std::move(other.pool_);
+        return *this;
+    }
+
+    ~pairing_heap_t() { clear(); }
+
+    [[nodiscard]] std::size_t size() const { return size_; }
+    [[nodiscard]] bool empty() const { return 0 == size_; }
+
+    //!\brief Return the head element of the heap.
+    [[nodiscard]] item_type const& top() const
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        return root_->item;
+    }
+
+    //!\brief Return the item referred to by 'handle'.
+    [[nodiscard]] item_type const& operator[](handle_type const handle) const { return handle.node_->item; }
+
+    //!\brief Remove the head element from the heap and return it.
+    [[nodiscard]] item_type pop_value()
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        auto result = std::move(root_->item);
+        pop();
+        return result;
+    }
+
+    //!\brief Remove the head element from the heap.
+    void pop()
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        auto* const old_root = root_;
+        root_ = merge_pairs(old_root->child);
+        pool_.destroy(old_root);
+        --size_;
+    }
+
+    //!\brief Add an element to the heap and return its handle.
+    handle_type push(item_type value)
+    {
+        auto* const node = pool_.create(node_type{std::move(value)});
+        root_ = link(root_, node);
+        ++size_;
+        return handle_type{node};
+    }
+
+    //!\brief Change the item referred to by 'handle' (increase or decrease its key.)
+    void update(handle_type const handle, item_type value)
+    {
+        auto* const node = handle.node_;
+        auto const move_value_up_tree = !cmp_op_type{}(node->item, value);
+        if (move_value_up_tree)
+        {
+            // The node's subtree still satisfies the heap property: cut it and link it with the root.
+            node->item = std::move(value);
+            if (root_ != node)
+            {
+                cut(node);
+                root_ = link(root_, node);
+            }
+        }
+        else
+        {
+            // The node's children may now belong above it: detach it, then reinsert it alone.
+            detach(node);
+            node->item = std::move(value);
+            root_ = link(root_, node);
+        }
+    }
+
+    //!\brief Remove the item referred to by 'handle' from the heap.
+    void erase(handle_type const handle)
+    {
+        detach(handle.node_);
+        pool_.destroy(handle.node_);
+        --size_;
+    }
+
+    //!\brief Move all elements of 'other' into this heap in O(1), leaving 'other' empty.
+    pairing_heap_t& meld(pairing_heap_t&& other)
+    {
+        if (this != &other)
+        {
+            root_ = link(root_, std::exchange(other.root_, nullptr));
+            size_ += std::exchange(other.size_, 0);
+            pool_.splice(other.pool_);
+        }
+
+        return *this;
+    }
+
+    //!\brief Remove all elements from the heap.
+    void clear()
+    {
+        // Destroy the nodes depth first, using each node's 'next' as the stack link.
+        auto* stack = root_;
+        while (nullptr != stack)
+        {
+            auto* const node = stack;
+            stack = node->next;
+            for (auto* child = node->child; nullptr != child; )
+            {
+                auto* const next_child = child->next;
+                child->next = stack;
+                stack = child;
+                child = next_child;
+            }
+            pool_.destroy(node);
+        }
+        root_ = nullptr;
+        size_ = 0;
+    }
+
+private:
+    //!\brief Link two trees: the root that belongs closer to the top becomes the parent (the first one on ties.)
+    static node_type* link(node_type* first, node_type* second)
+    {
+        if (nullptr == first) { return second; }
+        if (nullptr == second) { return first; }
+        if (cmp_op_type{}(second->item, first->item))
+        {
+            std::swap(first, second);
+        }
+
+        second->prev = first;
+        second->next = first->child;
+        if (nullptr != first->child)
+        {
+            first->child->prev = second;
+        }
+        first->child = second;
+        first->next = nullptr;
+        first->prev = nullptr;
+        return first;
+    }
+
+    //!\brief Two pass pairing: link siblings in pairs left to right, then link the pairs right to left.
+    static node_type* merge_pairs(node_type* first)
+    {
+        node_type* pairs = nullptr; // The linked pairs, last pair first (linked through 'next'.)
+        while (nullptr != first)
+        {
+            auto* const second = first->next;
+            auto* const rest = nullptr == second ? nullptr : second->next;
+            auto* const pair = link(first, second);
+            pair->next = pairs;
+            pairs = pair;
+            first = rest;
+        }
+
+        node_type* result = nullptr;
+        while (nullptr != pairs)
+        {
+            auto* const pair = pairs;
+            pairs = pair->next;
+            pair->next = nullptr;
+            result = link(pair, result);
+        }
+        if (nullptr != result)
+        {
+            result->prev = nullptr;
+        }
+        return result;
+    }
+
+    //!\brief Remove 'node' (a non root) and its subtree from its parent's list of children.
+    static void cut(node_type* const node)
+    {
+        if (node->prev->child == node)
+        {
+            node->prev->child = node->next;
+        }
+        else
+        {
+            node->prev->next = node->next;
+        }
+        if (nullptr != node->next)
+        {
+            node->next->prev = node->prev;
+        }
+        node->next = nullptr;
+        node->prev = nullptr;
+    }
+
+    //!\brief Remove 'node' from the tree, keeping its children in the heap.
+    void detach(node_type* const node)
+    {
+        if (root_ == node)
+        {
+            root_ = merge_pairs(node->child);
+        }
+        else
+        {
+            cut(node);
+            root_ = link(root_, merge_pairs(node->child));
+        }
+        node->child = nullptr;
+    }
+
+    node_type* root_ = nullptr;
+    std::size_t size_ = 0;
+    node_pool_t<node_type> pool_;
+};
+
+template <typename t_item_t>
+using max_pairing_heap_t = pairing_heap_t<t_item_t, std::greater<t_item_t>>;
+
+template <typename t_item_t>
+using min_pairing_heap_t = pairing_heap_t<t_item_t, std::less<t_item_t>>;
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+/*!
+    \brief Radix heap: a min heap of unsigned integer keys for monotone workloads.
+
+    Every pushed key must be at least the last popped (minimum) key, as is the
+    case in e.g. Dijkstra's algorithm or an event simulation.  An item is kept
+    in the bucket of the highest bit in which its key differs from the last
+    minimum (bucket 0 holds keys equal to it), so push() is O(1) and pop() is
+    O(log(C)) amortized, where C is the key range, without any comparisons
+    between items.  Offers the push/top/pop/pop_value surface of min_heap_t,
+    for (key, value) items.
+*/
+template <typename t_key_t, typename t_value_t>
+class radix_heap_t
+{
+public:
+    static_assert(std::is_integral_v<t_key_t> && std::is_unsigned_v<t_key_t>, "Keys must be unsigned integers");
+
+    using key_type = t_key_t;
+    using value_type = t_value_t;
+    using item_type = std::pair<key_type, value_type>;
+
+    static constexpr std::size_t bucket_count = std::numeric_limits<key_type>::digits + 1;
+
+    radix_heap_t() = default;
+
+    [[nodiscard]] std::size_t size() const { return size_; }
+    [[nodiscard]] bool empty() const { return 0 == size_; }
+
+    //!\brief Return the head element (an item with the minimum key) of the heap.
+    //!       Unless items with the last popped key remain, this scans the first non empty bucket.
+    [[nodiscard]] item_type const& top() const
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        if (!buckets_[0].empty())
+        {
+            return buckets_[0].back();
+        }
+
+        auto const& items = buckets_[first_non_empty_bucket()];
+        return *std::min_element(items.begin(), items.end(), key_less);
+    }
+
+    //!\brief Return the minimum key in the heap.
+    [[nodiscard]] key_type top_key() const { return top().first; }
+
+    //!\brief Remove the head element from the heap and return it.
+    [[nodiscard]] item_type pop_value()
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        refill();
+        auto result = std::move(buckets_[0].back());
+        buckets_[0].pop_back();
+        --size_;
+        return result;
+    }
+
+    //!\brief Remove the head element from the heap.
+    void pop()
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        refill();
+        buckets_[0].pop_back();
+        --size_;
+    }
+
+    //!\brief Add an element to the heap; its key may not be less than the last popped key.
+    radix_heap_t& push(item_type value)
+    {
+        if (value.first < last_) { throw std::out_of_range{"key is less than the last popped key"}; }
+        auto const bucket = bucket_of(value.first);
+        buckets_[bucket].emplace_back(std::move(value));
+        ++size_;
+
+        return *this;
+    }
+
+    //!\brief Add an element with key 'key' to the heap.
+    radix_heap_t& push(key_type const key, value_type value) { return push(item_type{key, std::move(value)}); }
+
+private:
+    //!\brief Return the bucket index for 'key': the bit width of the bits in which it differs from the minimum.
+    [[nodiscard]] std::size_t bucket_of(key_type const key) const
+    {
+        auto const differing_bits = static_cast<std::uint64_t>(key ^ last_);
+        if (0 == differing_bits)
+        {
+            return 0;
+        }
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(64 - __builtin_clzll(differing_bits));
+#else
+        std::size_t width = 0;
+        for (auto bits = differing_bits; 0 != bits; bits >>= 1)
+        {
+            ++width;
+        }
+        return width;
+#endif
+    }
+
+    static bool key_less(item_type const& lhs, item_type const& rhs) { return lhs.first < rhs.first; }
+
+    [[nodiscard]] std::size_t first_non_empty_bucket() const
+    {
+        auto bucket = std::size_t{0};
+        while (buckets_[bucket].empty())
+        {
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    //!\brief If bucket 0 is empty, make the least key of the first non empty bucket the new minimum and
+    //!       redistribute that bucket.  Each of its items moves to a strictly lower bucket, which bounds the
+    //!       amortized cost.
+    void refill()
+    {
+        auto const bucket = first_non_empty_bucket();
+        if (0 == bucket)
+        {
+            return;
+        }
+
+        auto& items = buckets_[bucket];
+        last_ = std::min_element(items.begin(), items.end(), key_less)->first;
+        for (auto& item : items)
+        {
+            buckets_[bucket_of(item.first)].emplace_back(std::move(item));
+        }
+        items.clear();
+    }
+
+    std::vector<item_type> buckets_[bucket_count];
+    key_type last_ = 0; //!< The last popped key; bucket 0 holds the items with this key.
+    std::size_t size_ = 0;
+};
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+/*!
+    \brief kway_merge_t source over the sorted range [begin, end).
+
+    The whole range is handed out as a single chunk, so its items are merged in place.
+*/
+template <typename t_iter_t>
+class range_source_t
+{
+public:
+    using iterator = t_iter_t;
+    using value_type = typename std::iterator_traits<t_iter_t>::value_type;
+
+    range_source_t(iterator begin, iterator end) : begin_{std::move(begin)}, end_{std::move(end)} {}
+
+    //!\brief Return the next chunk [first, second) of items; an empty chunk once the source is exhausted.
+    std::pair<iterator, iterator> next_chunk()
+    {
+        auto chunk = std::pair<iterator, iterator>{begin_, end_};
+        begin_ = end_;
+        return chunk;
+    }
+
+private:
+    iterator begin_;
+    iterator end_;
+};
+
+/*!
+    \brief kway_merge_t source that pulls sorted items from a generator, a chunk at a time.
+
+    The generator is called as 'generator(out, max_count)': it writes up to 'max_count'
+    items to 'out' (a t_item_t*), continuing the sorted sequence where the previous call
+    stopped, and returns the number of items written (0 once it is exhausted.)  A chunk
+    is valid until the next call of next_chunk().
+*/
+template <typename t_item_t, typename t_generator_t>
+class generator_source_t
+{
+public:
+    using iterator = t_item_t*;
+    using value_type = t_item_t;
+
+    explicit generator_source_t(t_generator_t generator, std::size_t const chunk_size = 256)
+        : generator_{std::move(generator)}
+        , chunk_(std::max<std::size_t>(1, chunk_size))
+    {
+    }
+
+    //!\brief Return the next chunk [first, second) of items; an empty chunk once the source is exhausted.
+    std::pair<iterator, iterator> next_chunk()
+    {
+        auto const count = std::min<std::size_t>(chunk_.size(), generator_(chunk_.data(), chunk_.size()));
+        return {chunk_.data(), chunk_.data() + count};
+    }
+
+private:
+    t_generator_t generator_;
+    std::vector<t_item_t> chunk_;
+};
+
+/*!
+    \brief Lazily merge sorted sources (see range_source_t and generator_source_t) into
+           a single sequence, sorted by 't_cmp_op_t' (std::less: ascending.)
+
+    A heap of cursors, one per source with items left and ordered by (next item, source
+    index), selects each next item; ties go to the lower source index, so the merge is
+    stable.  Advancing the head cursor is a single replace_top() on the cursor heap, and
+    a source is only asked for its next chunk once the current one is exhausted, so the
+    memory used is bounded by the sources' chunks and no item is copied before it is
+    taken.  Offers the top/pop/pop_value surface of heap_t, batched pull() and an input
+    range (begin/end.)
+*/
+template <
+    typename t_source_t
+    , typename t_cmp_op_t = std::less<typename t_source_t::value_type>
+    , std::size_t t_arity = 2
+>
+class kway_merge_t
+{
+public:
+    using source_type = t_source_t;
+    using value_type = typename source_type::value_type;
+    using cmp_op_type = t_cmp_op_t;
+
+    class iterator;
+
+    kway_merge_t() = default;
+
+    explicit kway_merge_t(std::vector<source_type> sources)
+        : sources_{std::move(sources)}
+    {
+        cursors_type cursors;
+        cursors.reserve(sources_.size());
+        for (std::size_t source = 0; sources_.size() > source; ++source)
+        {
+            auto const chunk = sources_[source].next_chunk();
+            if (chunk.first != chunk.second)
+            {
+                cursors.emplace_back(cursor_type{chunk.first, chunk.second, source});
+            }
+        }
+        cursors_ = cursor_heap_type{cursors.begin(), cursors.end()};
+    }
+
+    // Cursors point into the sources' chunks (moving the sources' vector keeps them in place.)
+    kway_merge_t(kway_merge_t const&) = delete;
+    kway_merge_t& operator=(kway_merge_t const&) = delete;
+    kway_merge_t(kway_merge_t&&) = default;
+    kway_merge_t& operator=(kway_merge_t&&) = default;
+
+    //!\brief Return true once all sources are exhausted.
+    [[nodiscard]] bool empty() const { return cursors_.empty(); }
+
+    //!\brief Return the number of sources with items left.
+    [[nodiscard]] std::size_t active_sources() const { return cursors_.size(); }
+
+    //!\brief Return the next item of the merged sequence.
+    [[nodiscard]] value_type const& top() const
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        return *cursors_.top().next;
+    }
+
+    //!\brief Remove the next item of the merged sequence.
+    void pop()
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        advance();
+    }
+
+    //!\brief Remove the next item of the merged sequence and return it (moved from its source.)
+    [[nodiscard]] value_type pop_value()
+    {
+        if (empty()) { throw std::out_of_range{"empty"}; }
+        auto result = std::move(*cursors_.top().next);
+        advance();
+        return result;
+    }
+
+    //!\brief Move up to 'max_count' next items of the merged sequence to 'out'; return the number of items moved.
+    template <typename O>
+    std::size_t pull(O out, std::size_t const max_count)
+    {
+        auto count = std::size_t{0};
+        for (; max_count > count && !empty(); ++count)
+        {
+            *out = std::move(*cursors_.top().next);
+            ++out;
+            advance();
+        }
+        return count;
+    }
+
+    //!\brief Return an input iterator over the rest of the merged sequence; incrementing it pops.
+    iterator begin() { return iterator{this}; }
+    iterator end() { return iterator{}; }
+
+private:
+    //!\brief The next item and the end of a source's current chunk.
+    struct cursor_type
+    {
+        typename source_type::iterator next;
+        typename source_type::iterator last;
+        std::size_t source;
+    };
+
+    //!\brief Order cursors so that the one with the first next item (and then the lowest source) is at the root.
+    struct cursor_cmp_op_type
+    {
+        bool operator()(cursor_type const& lhs, cursor_type const& rhs) const
+        {
+            if (cmp_op_type{}(*lhs.next, *rhs.next)) { return true; }
+            if (cmp_op_type{}(*rhs.next, *lhs.next)) { return false; }
+            return lhs.source < rhs.source;
+        }
+    };
+
+    using cursors_type = std::vector<cursor_type>;
+    using cursor_heap_type = heap_t<
+        cursor_type
+        , cursors_type
+        , heapify_t<typename cursors_type::iterator, cursor_cmp_op_type, t_arity>
+    >;
+
+    //!\brief Step the head cursor past its item, refilling its chunk or dropping it once its source is exhausted.
+    void advance()
+    {
+        auto cursor = cursors_.top();
+        ++cursor.next;
+        if (cursor.last == cursor.next)
+        {
+            std::tie(cursor.next, cursor.last) = sources_[cursor.source].next_chunk();
+        }
+
+        if (cursor.last == cursor.next)
+        {
+            cursors_.pop();
+        }
+        else
+        {
+            static_cast<void>(cursors_.replace_top(std::move(cursor)));
+        }
+    }
+
+    std::vector<source_type> sources_;
+    cursor_heap_type cursors_;
+};
+
+//!\brief Input iterator over a kway_merge_t: dereferencing reads top(), incrementing pops.
+template <typename t_source_t, typename t_cmp_op_t, std::size_t t_arity>
+class kway_merge_t<t_source_t, t_cmp_op_t, t_arity>::iterator
+{
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = typename kway_merge_t::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type const*;
+    using reference = value_type const&;
+
+    iterator() = default;
+    explicit iterator(kway_merge_t* merge) : merge_{nullptr != merge && !merge->empty() ? merge : nullptr} {}
+
+    reference operator*() const { return merge_->top(); }
+    pointer operator->() const { return &merge_->top(); }
+
+    iterator& operator++()
+    {
+        merge_->pop();
+        if (merge_->empty())
+        {
+            merge_ = nullptr; // Equal to end().
+        }
+        return *this;
+    }
+
+    void operator++(int) { ++*this; }
+
+    friend bool operator==(iterator const& lhs, iterator const& rhs) { return lhs.merge_ == rhs.merge_; }
+    friend bool operator!=(iterator const& lhs, iterator const& rhs) { return !(lhs == rhs); }
+
+private:
+    kway_merge_t* merge_ = nullptr;
+};
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+template <
+    class I
+    , typename t_heapify_t = max_heapify_t<I>
+>
+struct heap_sort_t
+{
+    using heapify_type = t_heapify_t;
+    using heapify_down_type = typename heapify_type::heapify_down_type;
+    using cmp_op_type = typename heapify_type::cmp_op_type;
+    using sift_policy_type = typename heapify_type::sift_policy_type;
+    using stats_type = typename heapify_type::stats_type;
+
+    static constexpr std::size_t arity = heapify_type::arity;
+
+    stats_type stats = {}; //!< E.g. counting_stats_t{&counters} (see heap_stats_t.)
+
+    constexpr void operator()(I begin, I end)
+    {
+        auto const empty = end == begin;
+        if (!empty)
+        {
+            heapify_type{{}, stats}(begin, end);
+            sort_heap(std::move(begin), std::move(end));
+        }
+    }
+
+    /*!
+        \brief Sort [begin, end) using multiple threads.
+
+        The range is split into one run per thread (of at least 'min_nodes_per_thread'
+        items), the runs are heap sorted concurrently and then merged.  The merge is a
+        k-way tournament: a heap of run cursors, ordered by each run's next item, moves
+        the items into a temporary buffer of (end - begin) items.  If the policy's
+        'max_buffer_items' is smaller than that, the runs are merged pairwise instead,
+        in place but for a buffer of at most that many items (with no buffer at all,
+        rotations do the merging, O(n*log(n)) moves.)  Heaps that collect stats are
+        sorted serially (the counters are not synchronized.)
+    */
+    void operator()(I begin, I end, parallel_policy_t const& policy)
+    {
+        using difference_type = typename std::iterator_traits<I>::difference_type;
+
+        auto const size = static_cast<std::size_t>(end - begin);
+        auto const run_count = std::min(policy.threads(), size / std::max<std::size_t>(1, policy.min_nodes_per_thread));
+        if (stats_type::is_enabled || 1 >= run_count)
+        {
+            (*this)(std::move(begin), std::move(end));
+            return;
+        }
+
+        // Balanced runs: [begin + run_bounds[idx], begin + run_bounds[idx + 1]).
+        std::vector<difference_type> run_bounds(run_count + 1);
+        for (std::size_t idx = 0; run_count >= idx; ++idx)
+        {
+            run_bounds[idx] = static_cast<difference_type>(size * idx / run_count);
+        }
+        parallel_for_ranges(std::size_t{0}, run_count, run_count, [&](std::size_t const first, std::size_t const last){
+            for (auto run = first; last > run; ++run)
+            {
+                (*this)(begin + run_bounds[run], begin + run_bounds[run + 1]);
+            }
+        });
+
+        if (size <= policy.max_buffer_items)
+        {
+            merge_runs(begin, run_bounds);
+        }
+        else
+        {
+            merge_runs_pairwise(begin, std::move(run_bounds), policy.max_buffer_items);
+        }
+    }
+
+    /*!
+        \brief Partially sort [begin, end) so that [begin, middle) holds the first
+               (middle - begin) items of the fully sorted range, in sorted order.
+
+        [begin, middle) is used as a bounded heap of k = (middle - begin) items that
+        each remaining item is either rejected by or replaces the root of, so the
+        time complexity is O(n*log(k)) instead of O(n*log(n)).  The order of the
+        items left in [middle, end) is unspecified.
+    */
+    constexpr void operator()(I begin, I middle, I end)
+    {
+        auto const empty = middle == begin;
+        if (!empty)
+        {
+            heapify_type{{}, stats}(begin, middle);
+            for (auto iter = middle; end != iter; ++iter)
+            {
+                // Replace the root (the "worst" kept item) with any item that belongs before it.
+                stats.compare();
+                if (cmp_op_type{}(*begin, *iter))
+                {
+                    auto value = std::move(*iter);
+                    *iter = std::move(*begin);
+                    heapify_down_type{{}, stats}(begin, middle, begin, std::move(value));
+                }
+            }
+            sort_heap(std::move(begin), std::move(middle));
+        }
+    }
+
+private:
+    using value_type = typename std::iterator_traits<I>::value_type;
+
+    //!\brief Return true if 'lhs' belongs before 'rhs' in the sorted order (the reverse of the heap order.)
+    static bool sorts_before(value_type const& lhs, value_type const& rhs) { return cmp_op_type{}(rhs, lhs); }
+
+    //!\brief The next item and the end of a sorted run.
+    struct run_cursor_type
+    {
+        I next;
+        I last;
+    };
+
+    //!\brief Order run cursors so that the one with the first next item is at the root.
+    struct run_cursor_cmp_op_type
+    {
+        bool operator()(run_cursor_type const& lhs, run_cursor_type const& rhs) const
+        {
+            return sorts_before(*lhs.next, *rhs.next);
+        }
+    };
+
+    //!\brief Merge the sorted runs of [begin, begin + run_bounds.back()) with a tournament of run cursors.
+    template <typename t_bounds_t>
+    static void merge_runs(I const begin, t_bounds_t const& run_bounds)
+    {
+        using cursors_type = std::vector<run_cursor_type>;
+        using cursor_heap_type = heap_t<
+            run_cursor_type
+            , cursors_type
+            , heapify_t<typename cursors_type::iterator, run_cursor_cmp_op_type>
+        >;
+
+        cursors_type runs;
+        runs.reserve(run_bounds.size() - 1);
+        for (std::size_t run = 0; run_bounds.size() - 1 > run; ++run)
+        {
+            runs.emplace_back(run_cursor_type{begin + run_bounds[run], begin + run_bounds[run + 1]});
+        }
+        auto cursors = cursor_heap_type{runs.begin(), runs.end()};
+
+        std::vector<value_type> buffer;
+        buffer.reserve(static_cast<std::size_t>(run_bounds.back()));
+        while (!cursors.empty())
+        {
+            auto cursor = cursors.top();
+            buffer.emplace_back(std::move(*cursor.next));
+            ++cursor.next;
+            if (cursor.last == cursor.next)
+            {
+                cursors.pop();
+            }
+            else
+            {
+                static_cast<void>(cursors.replace_top(cursor));
+            }
+        }
+        std::move(buffer.begin(), buffer.end(), begin);
+    }
+
+    //!\brief Merge the sorted runs of [begin, begin + run_bounds.back()) pairwise, using at most 'buffer_size' items.
+    template <typename t_bounds_t>
+    static void merge_runs_pairwise(I const begin, t_bounds_t run_bounds, std::size_t const buffer_size)
+    {
+        std::vector<value_type> buffer;
+        buffer.reserve(buffer_size);
+        while (2 < run_bounds.size())
+        {
+            auto merged_bounds = t_bounds_t{run_bounds.front()};
+            for (std::size_t run = 0; run_bounds.size() - 1 > run; run += 2)
+            {
+                if (run_bounds.size() - 2 > run)
+                {
+                    merge(begin + run_bounds[run], begin + run_bounds[run + 1], begin + run_bounds[run + 2], buffer);
+                }
+                merged_bounds.emplace_back(run_bounds[std::min(run + 2, run_bounds.size() - 1)]);
+            }
+            run_bounds = std::move(merged_bounds);
+        }
+    }
+
+    /*!
+        \brief Merge the sorted ranges [first, middle) and [middle, last) in place.
+
+        The shorter range is moved to 'buffer' (and merged from there) if it fits the
+        buffer's capacity; otherwise the ranges are split at a median, the inner
+        parts are swapped with a rotation, and both halves are merged recursively.
+    */
+    static void merge(I first, I middle, I last, std::vector<value_type>& buffer)
+    {
+        if (first == middle || middle == last || !sorts_before(*middle, *(middle - 1)))
+        {
+            return;
+        }
+
+        auto const left_size = static_cast<std::size_t>(middle - first);
+        auto const right_size = static_cast<std::size_t>(last - middle);
+        buffer.clear();
+        if (1 == left_size && 1 == right_size)
+        {
+            std::iter_swap(first, middle); // Out of order (checked above) and too small to split.
+        }
+        else if (left_size <= right_size && left_size <= buffer.capacity())
+        {
+            // Merge forward: the output never overtakes the right range.
+            std::move(first, middle, std::back_inserter(buffer));
+            auto left = buffer.begin();
+            auto right = middle;
+            auto out = first;
+            while (buffer.end() != left && last != right)
+            {
+                *out++ = sorts_before(*right, *left) ? std::move(*right++) : std::move(*left++);
+            }
+            std::move(left, buffer.end(), out);
+        }
+        else if (right_size <= buffer.capacity())
+        {
+            // Merge backward: the output never overtakes the left range.
+            std::move(middle, last, std::back_inserter(buffer));
+            auto left = middle;
+            auto right = buffer.end();
+            auto out = last;
+            while (buffer.begin() != right && first != left)
+            {
+                *--out = sorts_before(*(right - 1), *(left - 1)) ? std::move(*--left) : std::move(*--right);
+            }
+            std::move_backward(buffer.begin(), right, out);
+        }
+        else
+        {
+            auto left_cut = first;
+            auto right_cut = middle;
+            if (left_size > right_size)
+            {
+                left_cut += static_cast<std::ptrdiff_t>(left_size / 2);
+                right_cut = std::lower_bound(middle, last, *left_cut, sorts_before);
+            }
+            else
+            {
+                right_cut += static_cast<std::ptrdiff_t>(right_size / 2);
+                left_cut = std::upper_bound(first, middle, *right_cut, sorts_before);
+            }
+            auto const new_middle = std::rotate(left_cut, middle, right_cut);
+            merge(first, left_cut, new_middle, buffer);
+            merge(new_middle, right_cut, last, buffer);
+        }
+    }
+
+    //!\brief Sort the (already heapified) range [begin, end).
+    constexpr void sort_heap(I begin, I end) const
+    {
+        while (1 < end - begin)
+        {
+            --end; // Remove the last item from the collection.
+            auto value = std::move(*end);
+            *end = std::move(*begin); // Store the root in the unused space at the end of the collection.
+            // Heapify the last item down from the root.
+            heapify_down_type{{}, stats}(begin, end, begin, std::move(value));
+        }
+    }
+};
+
+template <class I, std::size_t t_arity = 2, typename t_sift_policy_t = top_down_sift_t>
+constexpr void heap_sort_ascending(I begin, I end)
+{
+    return heap_sort_t<I, max_heapify_t<I, t_arity, t_sift_policy_t>>{}(std::move(begin), std::move(end));
+}
+
+//!\brief Sort [begin, end) using multiple threads (see heap_sort_t.)
+template <class I, std::size_t t_arity = 2, typename t_sift_policy_t = top_down_sift_t>
+inline void heap_sort_ascending(I begin, I end, parallel_policy_t const& policy)
+{
+    return heap_sort_t<I, max_heapify_t<I, t_arity, t_sift_policy_t>>{}(std::move(begin), std::move(end), policy);
+}
+
+template <class T, std::size_t S>
+constexpr void heap_sort_ascending(T (&ary)[S])
+{
+    return heap_sort_ascending(ary, ary + S);
+}
+
+template <class I>
+constexpr void heap_sort(I begin, I end)
+{
+    return heap_sort_ascending(std::move(begin), std::move(end));
+}
+
+template <class T, std::size_t S>
+constexpr void heap_sort(T (&ary)[S])
+{
+    return heap_sort_ascending(ary);
+}
+
+template <class I, std::size_t t_arity = 2, typename t_sift_policy_t = top_down_sift_t>
+constexpr void heap_sort_decending(I begin, I end)
+{
+    return heap_sort_t<I, min_heapify_t<I, t_arity, t_sift_policy_t>>{}(std::move(begin), std::move(end));
+}
+
+//!\brief Sort [begin, end) using multiple threads (see heap_sort_t.)
+template <class I, std::size_t t_arity = 2, typename t_sift_policy_t = top_down_sift_t>
+inline void heap_sort_decending(I begin, I end, parallel_policy_t const& policy)
+{
+    return heap_sort_t<I, min_heapify_t<I, t_arity, t_sift_policy_t>>{}(std::move(begin), std::move(end), policy);
+}
+
+template <class T, std::size_t S>
+constexpr void heap_sort_decending(T (&ary)[S])
+{
+    return heap_sort_decending(ary, ary + S);
+}
+
+template <class I, std::size_t t_arity = 2, typename t_sift_policy_t = top_down_sift_t>
+constexpr void partial_heap_sort_ascending(I begin, I middle, I end)
+{
+    return heap_sort_t<I, max_heapify_t<I, t_arity, t_sift_policy_t>>{}(
+        std::move(begin)
+        , std::move(middle)
+        , std::move(end)
+    );
+}
+
+template <class I>
+constexpr void partial_heap_sort(I begin, I middle, I end)
+{
+    return partial_heap_sort_ascending(std::move(begin), std::move(middle), std::move(end));
+}
+
+template <class I, std::size_t t_arity = 2, typename t_sift_policy_t = top_down_sift_t>
+constexpr void partial_heap_sort_decending(I begin, I middle, I end)
+{
+    return heap_sort_t<I, min_heapify_t<I, t_arity, t_sift_policy_t>>{}(
+        std::move(begin)
+        , std::move(middle)
+        , std::move(end)
+    );
+}
+
+/*
+    End of "heap.h"
+*/
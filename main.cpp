@@ -11,379 +11,17 @@
 //!\sa https://github.com/doctest/doctest/blob/master/doc/markdown/main.md
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 
-#include <algorithm>
-#include <cassert>
+#include "heap.h"
+
 #include <doctest/doctest.h> //!\sa https://github.com/doctest/doctest/blob/master/doc/markdown/tutorial.md
-#include <functional>
-#include <iterator>
+#include <cmath>
+#include <cstdio>
 #include <iostream>
-#include <vector>
-
-// #define USE_RECURSIVE_HEAPIFY
-// #define USE_PRECISION_CHILD_OFFSET
+#include <sstream>
+#include <string>
 
 using namespace std;
 
-/*
-    left_child_idx = 2 * left_parent_idx + 1
-    right_child_idx = 2 * right_parent_idx + 2
-    left_parent_idx = (left_child_idx - 1) / 2
-    right_parent_idx = (right_child_idx - 2) / 2
-    Rule: left node indexes are always odd,
-          right node indexes are always even.
-*/
-template <
-    typename t_iter_t
-    , typename t_cmp_op_t = std::greater<
-        typename std::iterator_traits<t_iter_t>::value_type
-    >
->
-struct heapify_up_t
-{
-    using iter_type = t_iter_t;
-    using cmp_op_type = t_cmp_op_t;
-
-    void operator()(iter_type begin, iter_type node)
-    {
-#if defined(USE_RECURSIVE_HEAPIFY)
-        // Recursive implementation: space complexity = O(n)
-        //                           time complexity = O(lg(n))
-        auto const node_idx = node - begin;
-#if USE_PRECISION_CHILD_OFFSET
-        auto const child_offset = (1 << (~node_idx & 0x1)) & 0x3;
-#else // #if defined(USE_PRECISION_CHILD_OFFSET)
-        auto const child_offset = 1;
-#endif // #if defined(USE_PRECISION_CHILD_OFFSET)
-        auto const parent_idx = (node_idx - child_offset) / 2;
-        if (0 <= parent_idx)
-        {
-            auto parent = begin + parent_idx;
-            if (cmp_op_type{}(*node, *parent))
-            {
-                std::swap(*parent, *node);
-                heapify_up_t{}(std::move(begin), std::move(parent));
-            }
-        }
-#else // #if defined(USE_RECURSIVE_HEAPIFY)
-        // Iterative implementation: space complexity = O(1)
-        //                           time complexity = O(lg(n))
-        while (true)
-        {
-            auto const node_idx = node - begin;
-#if defined(USE_PRECISION_CHILD_OFFSET)
-            auto const child_offset = (1 << (~node_idx & 0x1)) & 0x3;
-#else // #if defined(USE_PRECISION_CHILD_OFFSET)
-            auto const child_offset = 1;
-#endif // #if defined(USE_PRECISION_CHILD_OFFSET)
-            auto const parent_idx = (node_idx - child_offset) / 2;
-            if (0 <= parent_idx)
-            {
-                auto parent = begin + parent_idx;
-                if (cmp_op_type{}(*node, *parent))
-                {
-                    std::swap(*parent, *node);
-                    node = parent;
-
-                    continue;
-                }
-            }
-
-            break;
-        }
-#endif // #if defined(USE_RECURSIVE_HEAPIFY)
-    }
-};
-
-template <
-    typename t_iter_t
-    , typename t_cmp_op_t = std::greater<
-        typename std::iterator_traits<t_iter_t>::value_type
-    >
->
-struct heapify_down_t
-{
-    using iter_type = t_iter_t;
-    using cmp_op_type = t_cmp_op_t;
-
-    void operator()(iter_type begin, iter_type end, iter_type node)
-    {
-        auto const ary_size = end - begin;
-        decltype(node) child = node;
-
-        while (true)
-        {
-            auto const node_idx = node - begin;
-
-            auto const left_child_idx = node_idx * 2 + 1;
-            auto left_child = begin + left_child_idx;
-            if (ary_size > left_child_idx
-                && cmp_op_type{}(*left_child, *child))
-            {
-                child = left_child;
-            }
-
-            auto const right_child_idx = node_idx * 2 + 2;
-            auto right_child = begin + right_child_idx;
-            if (ary_size > right_child_idx
-                && cmp_op_type{}(*right_child, *child))
-            {
-                child = right_child;
-            }
-        
-            auto const value_has_stopped_moving = node == child;
-            if (value_has_stopped_moving)
-            {
-                break;
-            }
-
-            std::swap(*child, *node);
-            node = child;
-        }
-    }
-};
-
-/*
-    Heap [complete] binary tree is left-weighted and stored in an array.
-
-     0 1 2 3 4 5 6 7 8 9   (array indexes)
-    [0 1 2 3 4 5 6 7 8 9]  (heap)
-
-          Unheapified (usually invalid; happend to be valid min heap due to initial array values):
-
-                0
-             1     2
-           3   4 5   6
-          7 8 9
-
-          Heapified (valid MAX heap):
-
-                9
-             8     5
-           6   7 1   4
-          0 3 2
-    
-     0 1 2 3 4 5 6 7 8 9   (array indexes)
-    [9 8 5 6 7 1 4 0 3 2]  (max heap)
-
-          Heapified (valid MIN heap):
-
-                0
-             1     2
-           3   4 5   6
-          7 8 9
-    
-     0 1 2 3 4 5 6 7 8 9   (array indexes)
-    [0 1 2 3 4 5 6 7 8 9]  (min heap)
-
-    Max heap:
-        o Add node to bottom leftmost available leaf.
-        o Recursively max_heapify_up_t upward while the new value is greater than the parent, until the root is reached.
-
-        for idx in range(0, size(ary)):
-            max_heapify_up_t(ary, idx)
-*/
-template <
-    typename t_iter_t
-    , typename t_cmp_op_t = std::greater<
-        typename std::iterator_traits<t_iter_t>::value_type
-    >
->
-struct heapify_t
-{
-    using iter_type = t_iter_t;
-    using heapify_up_type = heapify_up_t<iter_type, t_cmp_op_t>;
-    using heapify_down_type = heapify_down_t<iter_type, t_cmp_op_t>;
-    using cmp_op_type = t_cmp_op_t;
-
-    void operator()(iter_type begin, iter_type end)
-    {
-#if 0
-        // Do *NOT* do this!  Time complexity is O(n*log2(n))!
-        for (auto iter = begin; end != iter; ++iter)
-        {
-            heapify_up_type{}(begin, iter);
-        }
-#else // #if 0
-        if (1 < end - begin)
-        {
-            /*
-                Heapify DOWN on ONLY NON-leaf nodes, i.e. 1/2 of the nodes,
-                to heapify in O(n) [linear] time! :-)
-                Heapifying up on all nodes produces O(n*log2(n)) time. :-(
-            */
-            for (auto iter = begin + (end - begin - 1) / 2; begin <= iter; --iter)
-            {
-                heapify_down_type{}(begin, end, iter);
-            }
-        }
-#endif // #if 0
-    }
-};
-
-template<typename t_iter_t>
-using max_heapify_t = heapify_t<
-    t_iter_t
-    , std::greater<
-        typename std::iterator_traits<t_iter_t>::value_type
-    >
->;
-
-template<typename t_iter_t>
-using min_heapify_t = heapify_t<
-    t_iter_t
-    , std::less<
-        typename std::iterator_traits<t_iter_t>::value_type
-    >
->;
-
-template <
-    typename t_item_t
-    , typename t_container_t = std::vector<t_item_t>
-    , typename t_heapify_t = max_heapify_t<typename t_container_t::iterator>
->
-class heap_t
-{
-public:
-    using item_type = t_item_t;
-    using container_t = t_container_t;
-    using iterator = typename container_t::iterator;
-    using const_iterator = typename container_t::const_iterator;
-    using heapify_type = t_heapify_t;
-    using heapify_up_type = typename heapify_type::heapify_up_type;
-    using heapify_down_type = typename heapify_type::heapify_down_type;
-    using cmp_op_type = typename heapify_type::cmp_op_type;
-
-    heap_t() = default;
-
-    //!\brief Initialize from array.
-    template<typename A, std::size_t S>
-    heap_t(A const (&ary)[S])
-        : heap_t{ary, ary + S}
-    {
-        // Do nothing.
-    }
-
-    //!\brief Initialize from begin/end iterator pair.
-    template<typename I>
-    heap_t(I begin, I end)
-        : array_(begin, end)
-    {
-        heapify_type{}(this->begin(), this->end());
-    }
-    
-#if 0
-    // //!\brief Initialize from initializer list.
-    heap_t(std::initializer_list<item_type> list)
-        : array_(list.begin(), list.end())
-    {
-        heapify_type{}(array_.begin(), array_.end());
-    }
-#endif // #if 0
-    
-    //!\brief Initialize from initializer list, e.g. {1, 2, 3, 4, 5}.
-    template<typename... t_vals_t>
-    heap_t(item_type&& val1, t_vals_t&&... value)
-        : array_{std::forward<item_type>(val1), std::forward<t_vals_t>(value)...}
-    {
-        heapify_type{}(begin(), end());
-    }
-
-    [[nodiscard]] iterator begin() { return array_.begin(); }
-    [[nodiscard]] iterator end() { return array_.end(); }
-
-    [[nodiscard]] const_iterator begin() const { return array_.begin(); }
-    [[nodiscard]] const_iterator end() const { return array_.end(); }
-
-    [[nodiscard]] std::size_t size() const { return array_.size(); }
-    [[nodiscard]] bool empty() const { return array_.empty(); }
-    
-    [[nodiscard]] auto const& operator[](std::size_t idx) const { return array_[idx]; }
-    
-    //!\brief Remove the head element from the heap.
-    item_type top()
-    {
-        if (empty()) { throw std::out_of_range{"empty"}; }
-        return (*this)[0];
-    }
-    
-    //!\brief Remove the head element from the heap.
-    [[nodiscard]] item_type pop_value()
-    {
-        if (empty()) { throw std::out_of_range{"empty"}; }
-        auto const result = (*this)[0];
-        pop();
-        return result;
-    }
-    
-    //!\brief Remove the head element from the heap.
-    void pop()
-    {
-        if (empty()) { throw std::out_of_range{"empty"}; }
-        std::swap(*begin(), *(end() - 1));
-        array_.resize(size() - 1);
-        heapify_down_type{}(begin(), end(), begin());
-    }
-
-    //!\todo Add an element to the heap.
-    heap_t& push(item_type value)
-    {
-        // Add the item to the leftmost available child position in the tree.
-        // (Append the item to the array.)
-        array_.emplace_back(std::move(value));
-
-        // Heapify, starting from the new child to correctly position it within the tree.
-        heapify_up_type{}(begin(), end() - 1);
-
-        return *this;
-    }
-
-    //!\brief Add an element to or replace an element in the heap.
-    heap_t& insert(iterator position, item_type value)
-    {
-        if (end() == position)
-        {
-            push(std::move(value));
-        }
-        else if (*position == value)
-        {
-            // Update existing item (in case updating has side effects.)
-            *position = std::move(value);
-        }
-        else
-        {
-            auto const move_value_up_tree = cmp_op_type{}(value, *position);
-            *position = std::move(value);
-            if (move_value_up_tree)
-            {
-                heapify_up_type{}(begin(), std::move(position));
-            }
-            else
-            {
-                heapify_down_type{}(begin(), end(), std::move(position));
-            }
-        }
-
-        return *this;
-    }
-
-private:
-    container_t array_;
-};
-
-template <typename t_item_t>
-using max_heap_t = heap_t<
-    t_item_t
-    , std::vector<t_item_t>
-    , max_heapify_t<typename std::vector<t_item_t>::iterator>
->;
-
-template <typename t_item_t>
-using min_heap_t = heap_t<
-    t_item_t
-    , std::vector<t_item_t>
-    , min_heapify_t<typename std::vector<t_item_t>::iterator>
->;
-
 // [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
 
 template<std::size_t S>
@@ -424,73 +62,6 @@ operator<<(std::ostream& os, heap_t<I, V, H> const& heap)
 
 // [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
 
-template <
-    class I
-    , typename t_heapify_t = max_heapify_t<I>
->
-struct heap_sort_t
-{
-    using heapify_type = t_heapify_t;
-    using heapify_down_type = typename heapify_type::heapify_down_type;
-
-    void operator()(I begin, I end)
-    {
-        auto const empty = end == begin;
-        if (!empty)
-        {
-            heapify_type{}(begin, end);
-            while (begin < end)
-            {
-                auto const next_value = *begin;
-                *begin = std::move(*(end - 1)); // Move the last item in the tree to the root.
-                --end; // Remove the item from the collection.
-                heapify_down_type{}(begin, end, begin);
-                *end = std::move(next_value); // Store the removed value in the unused space at the end of the collection.
-            }
-        }
-    }
-};
-
-template <class I>
-inline void heap_sort_ascending(I begin, I end)
-{
-    return heap_sort_t<I, max_heapify_t<I>>{}(std::move(begin), std::move(end));
-}
-
-template <class T, std::size_t S>
-inline void heap_sort_ascending(T (&ary)[S])
-{
-    return heap_sort_ascending(ary, ary + S);
-}
-
-template <class I>
-inline void heap_sort(I begin, I end)
-{
-    return heap_sort_ascending(std::move(begin), std::move(end));
-}
-
-template <class T, std::size_t S>
-inline void heap_sort(T (&ary)[S])
-{
-    return heap_sort_ascending(ary);
-}
-
-template <class I>
-inline void heap_sort_decending(I begin, I end)
-{
-    return heap_sort_t<I, min_heapify_t<I>>{}(std::move(begin), std::move(end));
-}
-
-template <class T, std::size_t S>
-inline
-void
-heap_sort_decending(T (&ary)[S])
-{
-    return heap_sort_decending(ary, ary + S);
-}
-
-// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
-
 //!< Explicitly instantiate MAX heap template to ensure all of it compiles.
 template class heap_t<
     int
@@ -805,6 +376,2247 @@ TEST_CASE("min_heap_sort_descending")
     cout << std::endl;
 }
 
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!< Explicitly instantiate d-ary heap templates to ensure all of it compiles.
+template class heap_t<
+    int
+    , std::vector<int>
+    , max_heapify_t<typename std::vector<int>::iterator, 4>
+>;
+template class heap_t<
+    int
+    , std::vector<int>
+    , min_heapify_t<typename std::vector<int>::iterator, 8>
+>;
+
+TEST_CASE("dary_max_heap_heapification")
+{
+    /*
+            Heapified (valid 4-ary MAX heap):
+
+                    9
+               8       2  3  4
+            5 6 7 1    0
+
+         0 1 2 3 4 5 6 7 8 9   (array indexes)
+        [9 8 2 3 4 5 6 7 1 0]  (4-ary max heap)
+    */
+    cout << "((( dary_max_heap_heapification )))" << std::endl;
+    auto heap = max_heap_t<int, 4>{max_heap_init_val};
+    static int const heapified_val[] = { 9, 8, 2, 3, 4, 5, 6, 7, 1, 0 };
+    cout << "After heapification: " << heap << '\n';
+    CHECK(std::size(max_heap_init_val) == heap.size());
+    for (std::size_t idx = 0; std::size(heapified_val) > idx; ++idx)
+    {
+        CHECK(heapified_val[idx] == heap[idx]);
+    }
+
+    heap.push(10);
+    cout << "Extracting: ";
+    for (int expected_value = 10; !heap.empty(); --expected_value)
+    {
+        auto const value = heap.pop_value();
+        cout << value << ' ';
+        CHECK(value == expected_value);
+    }
+    cout << std::endl;
+}
+
+TEST_CASE("dary_min_heap_insert")
+{
+    cout << "((( dary_min_heap_insert )))" << std::endl;
+    auto heap = min_heap_t<int, 3>{min_heap_init_val};
+    heap.insert([&]{
+        auto iter = heap.begin();
+        for (; heap.end() != iter; ++iter)
+        {
+            if (5 == *iter)
+            {
+                break;
+            }
+        }
+        CHECK(heap.end() != iter);
+        return iter;
+    }(), -1);
+    cout << "Changed '5' to '-1': " << heap << '\n';
+    cout << "Extracting: ";
+    int const expected_values[] = { -1, 0, 1, 2, 3, 4, 6, 7, 8, 9 };
+    for (int idx = 0; std::size(expected_values) > idx; ++idx)
+    {
+        auto const value = heap.pop_value();
+        cout << value << ' ' << std::flush;
+        CHECK(value == expected_values[idx]);
+    }
+    cout << std::endl;
+}
+
+TEST_CASE("dary_heap_sort")
+{
+    cout << "((( dary_heap_sort )))" << std::endl;
+    int values[] = { 3, 9, 0, 7, 5, 1, 8, 2, 6, 4 };
+    cout << "Before sorting: " << values << '\n';
+    heap_sort_ascending<int*, 8>(std::begin(values), std::end(values));
+    cout << "After sorting (8-ary): " << values << '\n';
+    for (std::size_t idx = 0; std::size(values) > idx; ++idx)
+    {
+        CHECK(values[idx] == static_cast<int>(idx));
+    }
+    heap_sort_decending<int*, 4>(std::begin(values), std::end(values));
+    cout << "After sorting (4-ary): " << values << '\n';
+    for (std::size_t idx = 0; std::size(values) > idx; ++idx)
+    {
+        CHECK(values[idx] == static_cast<int>(std::size(values) - idx - 1));
+    }
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+TEST_CASE("heap_push_range")
+{
+    cout << "((( heap_push_range )))" << std::endl;
+    std::vector<int> values(1000);
+    for (std::size_t idx = 0; values.size() > idx; ++idx)
+    {
+        values[idx] = static_cast<int>((idx * 7919) % values.size());
+    }
+
+    // Small batch onto a large heap (heapified up one at a time.)
+    auto heap = max_heap_t<int>{values.begin(), values.begin() + 990};
+    heap.push_range(values.begin() + 990, values.end());
+    CHECK(values.size() == heap.size());
+
+    // Large batch onto a small heap (reheapified.)
+    auto dary_heap = min_heap_t<int, 4>{values.begin(), values.begin() + 10};
+    dary_heap.push_range(values.begin() + 10, values.end());
+    CHECK(values.size() == dary_heap.size());
+
+    for (std::size_t idx = 0; values.size() > idx; ++idx)
+    {
+        CHECK(heap.pop_value() == static_cast<int>(values.size() - idx - 1));
+        CHECK(dary_heap.pop_value() == static_cast<int>(idx));
+    }
+}
+
+TEST_CASE("heap_append")
+{
+    cout << "((( heap_append )))" << std::endl;
+    auto heap = max_heap_t<int>{};
+    heap.append(std::vector<int>{max_heap_init_val, max_heap_init_val + 5});
+    auto items = std::vector<int>{max_heap_init_val + 5, std::end(max_heap_init_val)};
+    heap.append(std::move(items));
+    CHECK(items.empty());
+    cout << "Appended: " << heap << '\n';
+    cout << "Extracting: ";
+    for (int expected_value = 9; !heap.empty(); --expected_value)
+    {
+        auto const value = heap.pop_value();
+        cout << value << ' ';
+        CHECK(value == expected_value);
+    }
+    cout << std::endl;
+}
+
+TEST_CASE("heap_pop_n")
+{
+    cout << "((( heap_pop_n )))" << std::endl;
+    auto heap = max_heap_t<int>{max_heap_init_val};
+    std::vector<int> top;
+    heap.pop_n(3, std::back_inserter(top));
+    CHECK((std::vector<int>{9, 8, 7}) == top);
+    CHECK(7 == heap.size());
+    CHECK(6 == heap.top());
+
+    int rest[10] = {};
+    auto const rest_end = heap.pop_n(100, std::begin(rest));
+    CHECK(std::begin(rest) + 7 == rest_end);
+    CHECK(heap.empty());
+    for (std::size_t idx = 0; 7 > idx; ++idx)
+    {
+        CHECK(rest[idx] == static_cast<int>(6 - idx));
+    }
+}
+
+TEST_CASE("partial_heap_sort")
+{
+    cout << "((( partial_heap_sort )))" << std::endl;
+    std::vector<int> values(1000);
+    for (std::size_t idx = 0; values.size() > idx; ++idx)
+    {
+        values[idx] = static_cast<int>((idx * 7919) % values.size());
+    }
+    auto top_values = values;
+
+    partial_heap_sort(values.begin(), values.begin() + 10, values.end());
+    partial_heap_sort_decending<std::vector<int>::iterator, 4>(
+        top_values.begin()
+        , top_values.begin() + 10
+        , top_values.end()
+    );
+    for (std::size_t idx = 0; 10 > idx; ++idx)
+    {
+        CHECK(values[idx] == static_cast<int>(idx));
+        CHECK(top_values[idx] == static_cast<int>(values.size() - idx - 1));
+    }
+
+    // The remaining items are all still present.
+    std::sort(values.begin(), values.end());
+    for (std::size_t idx = 0; values.size() > idx; ++idx)
+    {
+        CHECK(values[idx] == static_cast<int>(idx));
+    }
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!\brief Test item that counts how often it is copied and moved.
+struct counted_item_t
+{
+    static inline std::size_t copies = 0;
+    static inline std::size_t moves = 0;
+
+    int value = 0;
+
+    counted_item_t() = default;
+    counted_item_t(int val) : value{val} {}
+    counted_item_t(counted_item_t const& other) : value{other.value} { ++copies; }
+    counted_item_t(counted_item_t&& other) noexcept : value{other.value} { ++moves; }
+    counted_item_t& operator=(counted_item_t const& other) { value = other.value; ++copies; return *this; }
+    counted_item_t& operator=(counted_item_t&& other) noexcept { value = other.value; ++moves; return *this; }
+
+    friend bool operator<(counted_item_t const& lhs, counted_item_t const& rhs) { return lhs.value < rhs.value; }
+    friend bool operator>(counted_item_t const& lhs, counted_item_t const& rhs) { return lhs.value > rhs.value; }
+    friend bool operator==(counted_item_t const& lhs, counted_item_t const& rhs) { return lhs.value == rhs.value; }
+};
+
+TEST_CASE("hole_heapify_moves")
+{
+    cout << "((( hole_heapify_moves )))" << std::endl;
+    counted_item_t values[] = { 3, 9, 0, 7, 5, 1, 8, 2, 6, 4 };
+    counted_item_t::copies = 0;
+    counted_item_t::moves = 0;
+    heap_sort_ascending(values);
+    cout << "Copies: " << counted_item_t::copies << ", moves: " << counted_item_t::moves << '\n';
+    CHECK(0 == counted_item_t::copies);
+    for (std::size_t idx = 0; std::size(values) > idx; ++idx)
+    {
+        CHECK(values[idx].value == static_cast<int>(idx));
+    }
+
+    auto heap = max_heap_t<counted_item_t>{values};
+    counted_item_t::copies = 0;
+    counted_item_t::moves = 0;
+    heap.pop(); // Hole sift from the root of a 9 item heap: at most 3 levels.
+    cout << "Pop copies: " << counted_item_t::copies << ", moves: " << counted_item_t::moves << '\n';
+    CHECK(0 == counted_item_t::copies);
+    CHECK(5 >= counted_item_t::moves); // Lift the last item, at most 3 child moves, store the item.
+    CHECK(8 == heap[0].value);
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!\brief Test comparator that counts how often it is called.
+template <typename t_cmp_op_t>
+struct counted_cmp_op_t
+{
+    static inline std::size_t calls = 0;
+
+    template <typename T>
+    bool operator()(T const& lhs, T const& rhs) const
+    {
+        ++calls;
+        return t_cmp_op_t{}(lhs, rhs);
+    }
+};
+
+//!< Explicitly instantiate bottom-up heap template to ensure all of it compiles.
+template class heap_t<
+    int
+    , std::vector<int>
+    , max_heapify_t<typename std::vector<int>::iterator, 2, bottom_up_sift_t>
+>;
+
+TEST_CASE("bottom_up_heap_pop")
+{
+    cout << "((( bottom_up_heap_pop )))" << std::endl;
+    auto heap = max_heap_t<int, 2, bottom_up_sift_t>{max_heap_init_val};
+    heap.push(10);
+    cout << "Added '10': " << heap << '\n';
+    cout << "Extracting: ";
+    for (int expected_value = 10; !heap.empty(); --expected_value)
+    {
+        auto const value = heap.pop_value();
+        cout << value << ' ';
+        CHECK(value == expected_value);
+    }
+    cout << std::endl;
+
+    auto dary_heap = min_heap_t<int, 4, bottom_up_sift_t>{min_heap_init_val};
+    for (int expected_value = 0; !dary_heap.empty(); ++expected_value)
+    {
+        CHECK(dary_heap.pop_value() == expected_value);
+    }
+}
+
+TEST_CASE("bottom_up_heap_sort")
+{
+    cout << "((( bottom_up_heap_sort )))" << std::endl;
+    using cmp_op_type = counted_cmp_op_t<std::greater<int>>;
+    using iter_type = std::vector<int>::iterator;
+    using top_down_sort_type = heap_sort_t<iter_type, heapify_t<iter_type, cmp_op_type, 2, top_down_sift_t>>;
+    using bottom_up_sort_type = heap_sort_t<iter_type, heapify_t<iter_type, cmp_op_type, 2, bottom_up_sift_t>>;
+
+    std::vector<int> top_down_values(1000);
+    for (std::size_t idx = 0; top_down_values.size() > idx; ++idx)
+    {
+        top_down_values[idx] = static_cast<int>((idx * 7919) % top_down_values.size());
+    }
+    auto bottom_up_values = top_down_values;
+
+    cmp_op_type::calls = 0;
+    top_down_sort_type{}(top_down_values.begin(), top_down_values.end());
+    auto const top_down_calls = cmp_op_type::calls;
+
+    cmp_op_type::calls = 0;
+    bottom_up_sort_type{}(bottom_up_values.begin(), bottom_up_values.end());
+    auto const bottom_up_calls = cmp_op_type::calls;
+
+    cout << "Comparisons: top-down " << top_down_calls << ", bottom-up " << bottom_up_calls << '\n';
+    CHECK(std::is_sorted(bottom_up_values.begin(), bottom_up_values.end()));
+    CHECK(top_down_values == bottom_up_values);
+    CHECK(bottom_up_calls < top_down_calls);
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!< Explicitly instantiate addressable heap templates to ensure all of it compiles.
+template class indexed_heap_t<int>;
+template class indexed_heap_t<int, std::less<int>, 4, bottom_up_sift_t>;
+
+TEST_CASE("indexed_heap_update")
+{
+    cout << "((( indexed_heap_update )))" << std::endl;
+    auto heap = indexed_max_heap_t<int>{};
+    std::vector<indexed_max_heap_t<int>::handle_type> handles;
+    for (auto const value : max_heap_init_val)
+    {
+        handles.emplace_back(heap.push(value));
+    }
+    CHECK(std::size(max_heap_init_val) == heap.size());
+    CHECK(9 == heap.top());
+    CHECK(handles[9] == heap.top_handle());
+
+    heap.update(handles[5], 10); // Increase key.
+    heap.update(handles[9], -1); // Decrease key.
+    CHECK(10 == heap[handles[5]]);
+    CHECK(-1 == heap[handles[9]]);
+
+    cout << "Extracting: ";
+    int const expected_values[] = { 10, 8, 7, 6, 4, 3, 2, 1, 0, -1 };
+    for (std::size_t idx = 0; std::size(expected_values) > idx; ++idx)
+    {
+        auto const handle = heap.top_handle();
+        CHECK(heap.contains(handle));
+        auto const value = heap.pop_value();
+        cout << value << ' ';
+        CHECK(value == expected_values[idx]);
+        CHECK_FALSE(heap.contains(handle));
+    }
+    cout << std::endl;
+    CHECK_THROWS_AS(heap.top(), std::out_of_range);
+}
+
+TEST_CASE("indexed_heap_erase")
+{
+    cout << "((( indexed_heap_erase )))" << std::endl;
+    auto heap = indexed_min_heap_t<int, 3>{};
+    std::vector<indexed_min_heap_t<int, 3>::handle_type> handles;
+    for (auto const value : min_heap_init_val)
+    {
+        handles.emplace_back(heap.push(value));
+    }
+
+    // Erase '1', '7' and then the root ('0').
+    heap.erase(handles[5]);
+    heap.erase(handles[4]);
+    heap.erase(heap.top_handle());
+    CHECK_FALSE(heap.contains(handles[5]));
+    CHECK_THROWS_AS(heap.erase(handles[5]), std::out_of_range);
+    CHECK(7 == heap.size());
+
+    // Erased handles are reused; live handles still refer to their items.
+    auto const handle = heap.push(1);
+    CHECK(heap.contains(handle));
+    CHECK(8 == heap[handles[1]]);
+
+    cout << "Extracting: ";
+    int const expected_values[] = { 1, 2, 3, 4, 5, 6, 8, 9 };
+    for (std::size_t idx = 0; std::size(expected_values) > idx; ++idx)
+    {
+        auto const value = heap.pop_value();
+        cout << value << ' ';
+        CHECK(value == expected_values[idx]);
+    }
+    cout << std::endl;
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!\brief Test record: a small priority followed by a large payload.
+struct task_record_t
+{
+    int priority = 0;
+    char data[124] = {};
+};
+
+struct task_priority_t
+{
+    int operator()(task_record_t const& task) const { return task.priority; }
+};
+
+//!< Explicitly instantiate structure-of-arrays heap templates to ensure all of it compiles.
+template class soa_heap_t<task_record_t, task_priority_t>;
+template class soa_heap_t<task_record_t, task_priority_t, std::less<int>, 4, bottom_up_sift_t>;
+
+TEST_CASE("soa_heap_push_pop")
+{
+    cout << "((( soa_heap_push_pop )))" << std::endl;
+    std::vector<task_record_t> tasks(10);
+    for (std::size_t idx = 0; tasks.size() > idx; ++idx)
+    {
+        tasks[idx].priority = max_heap_init_val[idx];
+        tasks[idx].data[0] = static_cast<char>('a' + max_heap_init_val[idx]);
+    }
+
+    auto heap = soa_heap_t<task_record_t, task_priority_t>{tasks.begin(), tasks.end()};
+    CHECK(tasks.size() == heap.size());
+    CHECK(9 == heap.top_key());
+    CHECK('j' == heap.top().data[0]);
+
+    // Pop a few, then push so that freed payload slots are reused.
+    heap.pop();
+    CHECK(8 == heap.pop_value().priority);
+    heap.push(tasks[9]);
+    auto task = task_record_t{};
+    task.priority = 10;
+    task.data[0] = 'k';
+    heap.push(task);
+
+    cout << "Extracting: ";
+    for (int expected_value = 10; !heap.empty(); --expected_value)
+    {
+        if (8 == expected_value)
+        {
+            --expected_value;
+        }
+        auto const value = heap.pop_value();
+        cout << value.priority << ' ';
+        CHECK(value.priority == expected_value);
+        CHECK(value.data[0] == static_cast<char>('a' + expected_value));
+    }
+    cout << std::endl;
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!\brief Check that the (possibly SIMD) child selection matches a linear scan, including ties.
+template <typename t_key_t, typename t_cmp_op_t, std::size_t t_arity>
+void check_select_child()
+{
+    using select_child_type = select_child_t<t_key_t*, t_cmp_op_t, t_arity>;
+    cout << "    " << sizeof(t_key_t) << " byte keys, arity " << t_arity
+         << (select_child_type::is_simd ? ": SIMD" : ": scalar") << '\n';
+
+    t_key_t keys[t_arity] = {};
+    for (std::size_t round = 0; 200 > round; ++round)
+    {
+        for (std::size_t idx = 0; t_arity > idx; ++idx)
+        {
+            // A small value range so that ties are common.
+            auto const value = static_cast<int>((round * 7 + idx * 13 + round * idx) % 5) - 2;
+            keys[idx] = static_cast<t_key_t>(value);
+        }
+
+        auto expected = std::begin(keys);
+        for (auto sibling = std::begin(keys) + 1; std::end(keys) != sibling; ++sibling)
+        {
+            if (t_cmp_op_t{}(*sibling, *expected))
+            {
+                expected = sibling;
+            }
+        }
+        CHECK(expected == select_child_type{}(std::begin(keys), std::end(keys)));
+    }
+}
+
+template <typename t_key_t>
+void check_select_child()
+{
+    check_select_child<t_key_t, std::less<t_key_t>, 4>();
+    check_select_child<t_key_t, std::greater<t_key_t>, 4>();
+    check_select_child<t_key_t, std::less<t_key_t>, 8>();
+    check_select_child<t_key_t, std::greater<t_key_t>, 8>();
+}
+
+//!\brief Check that the child selection stays within the siblings when (some or all) keys are NaN.
+template <typename t_key_t, typename t_cmp_op_t, std::size_t t_arity>
+void check_select_child_nan()
+{
+    using select_child_type = select_child_t<t_key_t*, t_cmp_op_t, t_arity>;
+    t_key_t keys[t_arity] = {};
+    for (std::size_t nan_idx = 0; t_arity >= nan_idx; ++nan_idx)
+    {
+        // NaN from the front up to 'nan_idx' (all of them, in the last round.)
+        for (std::size_t idx = 0; t_arity > idx; ++idx)
+        {
+            keys[idx] = idx <= nan_idx ? std::numeric_limits<t_key_t>::quiet_NaN() : static_cast<t_key_t>(idx);
+        }
+        auto const child = select_child_type{}(std::begin(keys), std::end(keys));
+        CHECK(std::begin(keys) <= child);
+        CHECK(std::end(keys) > child);
+    }
+}
+
+template <typename t_key_t>
+void check_select_child_nan()
+{
+    check_select_child_nan<t_key_t, std::less<t_key_t>, 4>();
+    check_select_child_nan<t_key_t, std::greater<t_key_t>, 4>();
+    check_select_child_nan<t_key_t, std::less<t_key_t>, 8>();
+    check_select_child_nan<t_key_t, std::greater<t_key_t>, 8>();
+}
+
+TEST_CASE("simd_select_child")
+{
+    cout << "((( simd_select_child )))" << std::endl;
+    check_select_child<std::int32_t>();
+    check_select_child<std::uint32_t>();
+    check_select_child<float>();
+    check_select_child<std::int64_t>();
+    check_select_child<std::uint64_t>();
+    check_select_child<double>();
+    check_select_child_nan<float>();
+    check_select_child_nan<double>();
+
+    std::vector<double> values(1000);
+    for (std::size_t idx = 0; values.size() > idx; ++idx)
+    {
+        values[idx] = static_cast<double>((idx * 7919) % values.size()) / 4.0;
+    }
+    auto heap = min_heap_t<double, 8>{values.begin(), values.end()};
+    std::sort(values.begin(), values.end());
+    for (auto const value : values)
+    {
+        CHECK(value == heap.pop_value());
+    }
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!\brief Check that a layout's parent/first_child are consistent and that parents precede their children.
+template <typename t_layout_t>
+void check_layout(std::ptrdiff_t const size)
+{
+    constexpr auto d = static_cast<std::ptrdiff_t>(t_layout_t::arity);
+    CHECK(1 == t_layout_t::first_child(std::ptrdiff_t{0}));
+    for (std::ptrdiff_t idx = 1; size > idx; ++idx)
+    {
+        auto const parent = t_layout_t::parent(idx);
+        auto const first_child = t_layout_t::first_child(parent);
+        CHECK(parent < idx);
+        CHECK(first_child <= idx);
+        CHECK(first_child + d > idx);
+        CHECK(t_layout_t::last_parent(size) >= parent);
+    }
+}
+
+//!< Explicitly instantiate blocked layout heap templates to ensure all of it compiles.
+template class heap_t<
+    int
+    , std::vector<int>
+    , max_heapify_t<typename std::vector<int>::iterator, 2, top_down_sift_t, blocked_layout_t<2, 3>>
+>;
+template class heap_t<
+    int
+    , std::vector<int>
+    , min_heapify_t<typename std::vector<int>::iterator, 4, bottom_up_sift_t, page_blocked_layout_t<int, 4>>
+>;
+
+TEST_CASE("blocked_layout")
+{
+    cout << "((( blocked_layout )))" << std::endl;
+    static_assert(14 == blocked_layout_t<2, 3>::block_size);
+    static_assert(1022 == page_blocked_layout_t<int, 2>::block_size);
+    static_assert(340 == page_blocked_layout_t<int, 4>::block_size);
+    check_layout<flat_layout_t<2>>(1000);
+    check_layout<blocked_layout_t<2, 1>>(1000);
+    check_layout<blocked_layout_t<2, 3>>(1000);
+    check_layout<blocked_layout_t<4, 2>>(1000);
+    check_layout<blocked_layout_t<8, 2>>(1000);
+    check_layout<page_blocked_layout_t<int, 4>>(100000);
+
+    // A block height of 1 is the flat layout.
+    for (std::ptrdiff_t idx = 1; 1000 > idx; ++idx)
+    {
+        CHECK(flat_layout_t<3>::parent(idx) == blocked_layout_t<3, 1>::parent(idx));
+        CHECK(flat_layout_t<3>::first_child(idx) == blocked_layout_t<3, 1>::first_child(idx));
+    }
+}
+
+TEST_CASE("blocked_layout_heap")
+{
+    cout << "((( blocked_layout_heap )))" << std::endl;
+    std::vector<int> values(10000);
+    for (std::size_t idx = 0; values.size() > idx; ++idx)
+    {
+        values[idx] = static_cast<int>((idx * 7919) % values.size());
+    }
+
+    auto heap = max_heap_t<int, 2, top_down_sift_t, blocked_layout_t<2, 3>>{values.begin(), values.begin() + 5000};
+    for (auto iter = values.begin() + 5000; values.end() != iter; ++iter)
+    {
+        heap.push(*iter);
+    }
+    auto dary_heap = min_heap_t<int, 4, bottom_up_sift_t, page_blocked_layout_t<int, 4>>{values.begin(), values.end()};
+    CHECK(values.size() == heap.size());
+    CHECK(values.size() == dary_heap.size());
+    for (std::size_t idx = 0; values.size() > idx; ++idx)
+    {
+        CHECK(heap.pop_value() == static_cast<int>(values.size() - idx - 1));
+        CHECK(dary_heap.pop_value() == static_cast<int>(idx));
+    }
+
+    using iter_type = std::vector<int>::iterator;
+    heap_sort_t<iter_type, max_heapify_t<iter_type, 8, top_down_sift_t, blocked_layout_t<8, 2>>>{}(
+        values.begin()
+        , values.end()
+    );
+    CHECK(std::is_sorted(values.begin(), values.end()));
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+TEST_CASE("parallel_heapify")
+{
+    cout << "((( parallel_heapify )))" << std::endl;
+    std::vector<int> values(100000);
+    for (std::size_t idx = 0; values.size() > idx; ++idx)
+    {
+        values[idx] = static_cast<int>((idx * 7919) % values.size());
+    }
+
+    // Small per thread minimum so that most levels are heapified in parallel.
+    auto const policy = parallel_policy_t{4, 16};
+    auto heap = max_heap_t<int>{policy, values.begin(), values.end()};
+    auto serial_heap = max_heap_t<int>{values.begin(), values.end()};
+    CHECK(std::equal(heap.begin(), heap.end(), serial_heap.begin(), serial_heap.end()));
+
+    auto dary_heap = min_heap_t<int, 4>{policy, values.begin(), values.end()};
+    for (std::size_t idx = 0; values.size() > idx; ++idx)
+    {
+        CHECK(dary_heap.pop_value() == static_cast<int>(idx));
+    }
+
+    using iter_type = std::vector<int>::iterator;
+    heap_sort_t<iter_type, max_heapify_t<iter_type, 8>>{}(values.begin(), values.end(), policy);
+    CHECK(std::is_sorted(values.begin(), values.end()));
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!< Explicitly instantiate MultiQueue templates to ensure all of it compiles.
+template class multi_queue_t<int>;
+template class multi_queue_t<int, min_heap_t<int, 4>>;
+
+TEST_CASE("multi_queue_single_thread")
+{
+    cout << "((( multi_queue_single_thread )))" << std::endl;
+    auto queue = multi_queue_t<int>{1, 4, 8};
+    CHECK(4 == queue.shard_count());
+    std::vector<int> popped;
+    {
+        auto handle = queue.get_handle();
+        for (int value = 0; 1000 > value; ++value)
+        {
+            handle.push(value);
+        }
+        auto const value = handle.try_pop();
+        REQUIRE(value.has_value());
+        popped.emplace_back(*value);
+    }
+    CHECK(999 == queue.size()); // The destroyed handle flushed its buffers.
+
+    auto handle = queue.get_handle();
+    while (auto const value = handle.try_pop())
+    {
+        popped.emplace_back(*value);
+    }
+    CHECK(queue.empty());
+    REQUIRE(1000 == popped.size());
+    std::sort(popped.begin(), popped.end());
+    for (std::size_t idx = 0; popped.size() > idx; ++idx)
+    {
+        CHECK(popped[idx] == static_cast<int>(idx));
+    }
+}
+
+TEST_CASE("multi_queue_threads")
+{
+    cout << "((( multi_queue_threads )))" << std::endl;
+    constexpr std::size_t thread_count = 4;
+    constexpr int values_per_thread = 10000;
+    auto queue = multi_queue_t<int, min_heap_t<int>>{thread_count};
+    std::atomic<long long> popped_sum{0};
+    std::atomic<std::size_t> popped_count{0};
+
+    std::vector<std::thread> threads;
+    for (std::size_t thread_idx = 0; thread_count > thread_idx; ++thread_idx)
+    {
+        threads.emplace_back([&, thread_idx]{
+            auto handle = queue.get_handle();
+            for (int value = 0; values_per_thread > value; ++value)
+            {
+                handle.push(static_cast<int>(thread_idx) * values_per_thread + value);
+                if (0 == value % 3)
+                {
+                    if (auto const popped = handle.try_pop())
+                    {
+                        popped_sum += *popped;
+                        ++popped_count;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    auto handle = queue.get_handle();
+    while (auto const popped = handle.try_pop())
+    {
+        popped_sum += *popped;
+        ++popped_count;
+    }
+
+    constexpr auto total = static_cast<long long>(thread_count) * values_per_thread;
+    CHECK(static_cast<std::size_t>(total) == popped_count.load());
+    CHECK(total * (total - 1) / 2 == popped_sum.load());
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!< Explicitly instantiate pairing heap templates to ensure all of it compiles.
+template class pairing_heap_t<int>;
+template class pairing_heap_t<std::string, std::less<std::string>>;
+
+TEST_CASE("pairing_heap_push_pop")
+{
+    cout << "((( pairing_heap_push_pop )))" << std::endl;
+    auto heap = max_pairing_heap_t<int>{};
+    for (auto const value : max_heap_init_val)
+    {
+        heap.push(value);
+    }
+    heap.push(10);
+    CHECK(11 == heap.size());
+    cout << "Extracting: ";
+    for (int expected_value = 10; !heap.empty(); --expected_value)
+    {
+        auto const value = heap.pop_value();
+        cout << value << ' ';
+        CHECK(value == expected_value);
+    }
+    cout << std::endl;
+    CHECK_THROWS_AS(heap.pop(), std::out_of_range);
+}
+
+TEST_CASE("pairing_heap_update_erase")
+{
+    cout << "((( pairing_heap_update_erase )))" << std::endl;
+    auto heap = min_pairing_heap_t<std::string>{};
+    std::vector<min_pairing_heap_t<std::string>::handle_type> handles;
+    for (auto const value : min_heap_init_val)
+    {
+        handles.emplace_back(heap.push(std::string(1, static_cast<char>('a' + value))));
+    }
+
+    heap.update(handles[5], "z"); // 'b' -> 'z' (moves down.)
+    heap.update(handles[0], "A"); // 'j' -> 'A' (moves up.)
+    heap.erase(handles[7]); // 'a' (the root.)
+    heap.erase(handles[4]); // 'h'
+    CHECK("z" == heap[handles[5]]);
+
+    std::string extracted;
+    while (!heap.empty())
+    {
+        extracted += heap.pop_value();
+    }
+    cout << "Extracting: " << extracted << '\n';
+    CHECK("Acdefgiz" == extracted);
+}
+
+TEST_CASE("pairing_heap_meld")
+{
+    cout << "((( pairing_heap_meld )))" << std::endl;
+    auto heap = max_pairing_heap_t<int>{};
+    auto other = max_pairing_heap_t<int>{};
+    for (int value = 0; 1000 > value; ++value)
+    {
+        (value % 3 ? heap : other).push((value * 7919) % 1000);
+    }
+    auto const handle = other.push(5000);
+    heap.meld(std::move(other));
+    CHECK(other.empty());
+    CHECK(1001 == heap.size());
+    heap.update(handle, -1); // Melded handles stay valid.
+
+    // The melded heap's nodes (and the pool storage they came from) remain usable.
+    other.push(1);
+    CHECK(1 == other.pop_value());
+    for (int expected_value = 999; -1 <= expected_value; --expected_value)
+    {
+        CHECK(heap.pop_value() == expected_value);
+    }
+    CHECK(heap.empty());
+}
+
+TEST_CASE("heap_merge")
+{
+    cout << "((( heap_merge )))" << std::endl;
+    auto heap = max_heap_t<int>{max_heap_init_val, max_heap_init_val + 3};
+    auto other = max_heap_t<int>{max_heap_init_val + 3, std::end(max_heap_init_val)};
+    heap.merge(std::move(other));
+    CHECK(other.empty());
+    CHECK(10 == heap.size());
+    for (int expected_value = 9; !heap.empty(); --expected_value)
+    {
+        CHECK(heap.pop_value() == expected_value);
+    }
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!< Explicitly instantiate radix heap templates to ensure all of it compiles.
+template class radix_heap_t<std::uint32_t, int>;
+template class radix_heap_t<std::uint8_t, std::string>;
+
+TEST_CASE("radix_heap_push_pop")
+{
+    cout << "((( radix_heap_push_pop )))" << std::endl;
+    auto heap = radix_heap_t<std::uint32_t, int>{};
+    for (auto const value : min_heap_init_val)
+    {
+        heap.push(static_cast<std::uint32_t>(value) * 1000u, value);
+    }
+    CHECK(10 == heap.size());
+    cout << "Extracting: ";
+    for (int expected_value = 0; !heap.empty(); ++expected_value)
+    {
+        CHECK(static_cast<std::uint32_t>(expected_value) * 1000u == heap.top_key());
+        auto const item = heap.pop_value();
+        cout << item.second << ' ';
+        CHECK(item.second == expected_value);
+    }
+    cout << std::endl;
+    CHECK_THROWS_AS(heap.pop(), std::out_of_range);
+}
+
+TEST_CASE("radix_heap_monotone")
+{
+    cout << "((( radix_heap_monotone )))" << std::endl;
+    // Interleave pushes (never below the last popped key) and pops, against min_heap_t as the reference.
+    auto heap = radix_heap_t<std::uint64_t, std::size_t>{};
+    auto reference = min_heap_t<std::uint64_t>{};
+    auto last_popped = std::uint64_t{0};
+    for (std::size_t idx = 0; 5000 > idx; ++idx)
+    {
+        heap.push(last_popped + (idx * 7919) % 1000, idx);
+        reference.push(last_popped + (idx * 7919) % 1000);
+        if (0 == idx % 3)
+        {
+            CHECK(heap.top_key() == reference.top());
+            last_popped = heap.pop_value().first;
+            CHECK(last_popped == reference.pop_value());
+        }
+    }
+    while (!heap.empty())
+    {
+        CHECK(heap.pop_value().first == reference.pop_value());
+    }
+    CHECK(reference.empty());
+
+    auto bounded = radix_heap_t<std::uint8_t, std::string>{};
+    bounded.push(255, "max").push(7, "seven").push(9, "nine");
+    CHECK("seven" == bounded.pop_value().second);
+    bounded.push(8, "eight"); // Less than the minimum (9) but not than the last popped key (7.)
+    CHECK("eight" == bounded.pop_value().second);
+    CHECK("nine" == bounded.pop_value().second);
+    CHECK_THROWS_AS(bounded.push(6, "six"), std::out_of_range);
+    CHECK("max" == bounded.top().second);
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!< Explicitly instantiate allocator aware heap templates to ensure all of it compiles.
+template class heap_t<
+    int
+    , std::vector<int>
+    , max_heapify_t<typename std::vector<int>::iterator>
+    , hysteresis_shrink_t<>
+>;
+template class heap_t<
+    int
+    , std::pmr::vector<int>
+    , min_heapify_t<typename std::pmr::vector<int>::iterator>
+>;
+
+TEST_CASE("heap_reserve_shrink")
+{
+    cout << "((( heap_reserve_shrink )))" << std::endl;
+    auto heap = max_heap_t<int>{};
+    heap.reserve(1000);
+    CHECK(1000 <= heap.capacity());
+    auto const capacity = heap.capacity();
+    for (int value = 0; 1000 > value; ++value)
+    {
+        heap.push((value * 7919) % 1000);
+    }
+    CHECK(capacity == heap.capacity());
+
+    // Popping never releases storage under the default policy; shrink_to_fit() does.
+    std::vector<int> popped;
+    heap.pop_n(990, std::back_inserter(popped));
+    CHECK(capacity == heap.capacity());
+    heap.shrink_to_fit();
+    CHECK(10 == heap.capacity());
+    CHECK(9 == heap.pop_value());
+
+    using shrinking_heap_t = heap_t<
+        int
+        , std::vector<int>
+        , max_heapify_t<typename std::vector<int>::iterator>
+        , hysteresis_shrink_t<4, 64>
+    >;
+    auto shrinking = shrinking_heap_t{};
+    for (int value = 0; 1024 > value; ++value)
+    {
+        shrinking.push((value * 7919) % 1024);
+    }
+    auto const full_capacity = shrinking.capacity();
+    while (full_capacity / 4 + 1 < shrinking.size())
+    {
+        shrinking.pop();
+    }
+    CHECK(full_capacity == shrinking.capacity()); // Not yet: the size has to drop to a quarter.
+    shrinking.pop();
+    CHECK(2 * shrinking.size() == shrinking.capacity());
+    for (int expected_value = static_cast<int>(shrinking.size()) - 1; !shrinking.empty(); --expected_value)
+    {
+        CHECK(shrinking.pop_value() == expected_value);
+    }
+    CHECK(64 == shrinking.capacity());
+}
+
+TEST_CASE("pmr_heap")
+{
+    cout << "((( pmr_heap )))" << std::endl;
+    // All storage comes from the arena: the upstream resource refuses to allocate.
+    std::byte buffer[16 * 1024];
+    auto arena = std::pmr::monotonic_buffer_resource{buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+    auto heap = pmr_min_heap_t<int, 4>{std::begin(min_heap_init_val), std::end(min_heap_init_val), &arena};
+    CHECK(&arena == heap.get_allocator().resource());
+    heap.reserve(100);
+    for (int value = 10; 100 > value; ++value)
+    {
+        heap.push(value);
+    }
+    for (int expected_value = 0; !heap.empty(); ++expected_value)
+    {
+        CHECK(heap.pop_value() == expected_value);
+    }
+
+    auto pool = std::pmr::unsynchronized_pool_resource{&arena};
+    auto pooled = pmr_max_heap_t<int>{&pool};
+    pooled.push(1).push(3).push(2);
+    pooled.shrink_to_fit();
+    CHECK(&pool == pooled.get_allocator().resource());
+    CHECK(3 == pooled.pop_value());
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!< Explicitly instantiate static heap templates to ensure all of it compiles.
+template class static_heap_t<int, 10>;
+template class static_heap_t<std::string, 64, std::less<std::string>, 4, bottom_up_sift_t>;
+
+TEST_CASE("static_heap_push_pop")
+{
+    cout << "((( static_heap_push_pop )))" << std::endl;
+    auto heap = static_max_heap_t<int, 10>{};
+    for (auto const value : max_heap_init_val)
+    {
+        CHECK(heap.try_push(value));
+    }
+    CHECK(heap.full());
+    CHECK_FALSE(heap.try_push(10));
+    CHECK_THROWS_AS(heap.push(10), std::out_of_range);
+
+    auto copy = heap;
+    cout << "Extracting: ";
+    for (int expected_value = 9; !heap.empty(); --expected_value)
+    {
+        auto const value = heap.pop_value();
+        cout << value << ' ';
+        CHECK(value == expected_value);
+    }
+    cout << std::endl;
+    CHECK_THROWS_AS(heap.pop(), std::out_of_range);
+    CHECK(10 == copy.size());
+    CHECK(9 == copy.top());
+}
+
+TEST_CASE("static_heap_items")
+{
+    cout << "((( static_heap_items )))" << std::endl;
+    // Non trivial items are constructed and destroyed in place.
+    auto heap = static_min_heap_t<std::string, 64, 4>{};
+    for (int value = 0; 64 > value; ++value)
+    {
+        heap.push(std::to_string(1000 + (value * 7919) % 64));
+    }
+    CHECK_FALSE(heap.try_push("0"));
+    CHECK("1000" == heap.pop_value());
+    CHECK(heap.try_push("0"));
+
+    auto moved = std::move(heap);
+    CHECK(heap.empty());
+    CHECK("0" == moved.pop_value());
+    for (int expected_value = 1001; !moved.empty(); ++expected_value)
+    {
+        CHECK(std::to_string(expected_value) == moved.pop_value());
+    }
+
+    auto built = static_max_heap_t<int, 10, 4>{std::begin(max_heap_init_val), std::end(max_heap_init_val)};
+    CHECK(9 == built.top());
+    CHECK_THROWS_AS((static_max_heap_t<int, 5>{std::begin(max_heap_init_val), std::end(max_heap_init_val)}),
+                    std::out_of_range);
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!\brief Return true if the 'S' items of 'lhs' and 'rhs' are equal (std::equal is not constexpr until C++20.)
+template <typename T, std::size_t S>
+constexpr bool constexpr_equal(std::array<T, S> const& lhs, T const (&rhs)[S])
+{
+    for (std::size_t idx = 0; S > idx; ++idx)
+    {
+        if (lhs[idx] != rhs[idx])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//!\brief Copy 'ary', apply 'fn' to the copy's [begin, end) and return the copy.
+template <typename T, std::size_t S, typename F>
+constexpr std::array<T, S> constexpr_apply(T const (&ary)[S], F const& fn)
+{
+    std::array<T, S> result{};
+    for (std::size_t idx = 0; S > idx; ++idx)
+    {
+        result[idx] = ary[idx];
+    }
+    fn(result.data(), result.data() + S);
+    return result;
+}
+
+//!< Heapify, sort and partially sort at compile time.
+static constexpr int constexpr_init_val[] = { 3, 7, 0, 9, 1, 8, 2, 6, 4, 5 };
+
+static constexpr int constexpr_max_heap_val[] = { 9, 7, 8, 6, 5, 0, 2, 3, 4, 1 };
+static_assert(constexpr_equal(
+    constexpr_apply(constexpr_init_val, [](int* begin, int* end){ max_heapify_t<int*>{}(begin, end); })
+    , constexpr_max_heap_val
+));
+
+static constexpr int constexpr_ascending_val[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+static constexpr int constexpr_decending_val[] = { 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 };
+static_assert(constexpr_equal(
+    constexpr_apply(constexpr_init_val, [](int* begin, int* end){ heap_sort(begin, end); })
+    , constexpr_ascending_val
+));
+static_assert(constexpr_equal(
+    constexpr_apply(constexpr_init_val, [](int* begin, int* end){
+        heap_sort_decending<int*, 4, bottom_up_sift_t>(begin, end);
+    })
+    , constexpr_decending_val
+));
+static_assert(constexpr_apply(constexpr_init_val, [](int* begin, int* end){
+    partial_heap_sort_ascending<int*, 8>(begin, begin + 3, end);
+})[2] == 2);
+
+struct dispatch_entry_t
+{
+    int priority;
+    std::size_t idx;
+
+    //!\brief Higher priorities first, and earlier indexes first on ties.
+    constexpr bool operator>(dispatch_entry_t const& other) const
+    {
+        return priority > other.priority || (priority == other.priority && idx < other.idx);
+    }
+};
+
+//!\brief Return the indexes of 'priorities', highest priority first (e.g. a static dispatch order.)
+template <std::size_t S>
+constexpr std::array<std::size_t, S> constexpr_dispatch_order(int const (&priorities)[S])
+{
+    auto heap = static_heap_t<dispatch_entry_t, S>{};
+    for (std::size_t idx = 0; S > idx; ++idx)
+    {
+        heap.push({priorities[idx], idx});
+    }
+
+    std::array<std::size_t, S> order{};
+    for (std::size_t idx = 0; !heap.empty(); ++idx)
+    {
+        order[idx] = heap.pop_value().idx;
+    }
+    return order;
+}
+
+static constexpr int constexpr_priorities[] = { 2, 9, 4, 9, 0 };
+static constexpr std::size_t constexpr_dispatch_order_val[] = { 1, 3, 2, 0, 4 };
+static constexpr auto constexpr_dispatch_order_table = constexpr_dispatch_order(constexpr_priorities);
+static_assert(constexpr_equal(constexpr_dispatch_order_table, constexpr_dispatch_order_val));
+
+static_assert([]{
+    auto heap = static_min_heap_t<int, 4, 4>{};
+    auto const pushed = heap.try_push(3) && heap.try_push(1) && heap.try_push(2) && heap.try_push(0);
+    return pushed && !heap.try_push(5) && heap.full() && 0 == heap.top();
+}());
+
+TEST_CASE("constexpr_heap")
+{
+    cout << "((( constexpr_heap )))" << std::endl;
+    // The same table at run time (where the SIMD child selection, if enabled, takes part.)
+    auto heap = static_min_heap_t<int, 10, 4>{std::begin(constexpr_init_val), std::end(constexpr_init_val)};
+    for (int expected_value = 0; !heap.empty(); ++expected_value)
+    {
+        CHECK(heap.pop_value() == expected_value);
+    }
+    auto const dispatch_order = constexpr_dispatch_order(constexpr_priorities);
+    for (std::size_t idx = 0; dispatch_order.size() > idx; ++idx)
+    {
+        cout << dispatch_order[idx] << ' ';
+        CHECK(constexpr_dispatch_order_table[idx] == dispatch_order[idx]);
+    }
+    cout << std::endl;
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!\brief Test comparator that orders (move-only) pointers by their pointees.
+struct pointee_greater_t
+{
+    template <typename P>
+    bool operator()(P const& lhs, P const& rhs) const { return *lhs > *rhs; }
+};
+
+using unique_ptr_iter_t = typename std::vector<std::unique_ptr<int>>::iterator;
+using unique_ptr_heapify_t = heapify_t<unique_ptr_iter_t, pointee_greater_t>;
+
+//!< Explicitly instantiate move-only heap templates to ensure all of it compiles.
+template class heap_t<std::unique_ptr<int>, std::vector<std::unique_ptr<int>>, unique_ptr_heapify_t>;
+template struct heap_sort_t<unique_ptr_iter_t, unique_ptr_heapify_t>;
+
+TEST_CASE("move_only_heap")
+{
+    cout << "((( move_only_heap )))" << std::endl;
+    auto heap = heap_t<std::unique_ptr<int>, std::vector<std::unique_ptr<int>>, unique_ptr_heapify_t>{
+        std::make_unique<int>(3), std::make_unique<int>(7), std::make_unique<int>(5)
+    };
+    for (auto const value : max_heap_init_val)
+    {
+        heap.emplace(new int{value});
+    }
+    CHECK(9 == *heap.top());
+    CHECK(&*heap.top() == &*heap.top()); // A reference to the root, not a copy.
+
+    std::vector<std::unique_ptr<int>> popped;
+    popped.emplace_back(heap.pop_value());
+    heap.pop_n(heap.size(), std::back_inserter(popped));
+    int const expected_values[] = { 9, 8, 7, 7, 6, 5, 5, 4, 3, 3, 2, 1, 0 };
+    CHECK(std::size(expected_values) == popped.size());
+    for (std::size_t idx = 0; popped.size() > idx; ++idx)
+    {
+        CHECK(expected_values[idx] == *popped[idx]);
+    }
+
+    heap_sort_t<unique_ptr_iter_t, unique_ptr_heapify_t>{}(popped.begin(), popped.end());
+    for (std::size_t idx = 1; popped.size() > idx; ++idx)
+    {
+        CHECK(*popped[idx - 1] <= *popped[idx]);
+    }
+}
+
+TEST_CASE("heap_pop_value_moves")
+{
+    cout << "((( heap_pop_value_moves )))" << std::endl;
+    counted_item_t::copies = 0;
+    auto heap = max_heap_t<counted_item_t>{counted_item_t{3}, counted_item_t{9}, counted_item_t{0}};
+    heap.emplace(7);
+    CHECK(9 == heap.top().value);
+    auto const value = heap.pop_value();
+    CHECK(9 == value.value);
+    CHECK(7 == heap.pop_value().value);
+    cout << "Copies: " << counted_item_t::copies << '\n';
+    CHECK(0 == counted_item_t::copies);
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+using stats_cmp_op_t = counted_cmp_op_t<std::greater<int>>;
+using stats_heapify_t = heapify_t<
+    typename std::vector<int>::iterator
+    , stats_cmp_op_t
+    , 4
+    , bottom_up_sift_t
+    , flat_layout_t<4>
+    , null_slot_observer_t
+    , counting_stats_t<>
+>;
+using checked_heapify_t = heapify_t<
+    typename std::vector<int>::iterator
+    , std::greater<int>
+    , 4
+    , bottom_up_sift_t
+    , flat_layout_t<4>
+    , null_slot_observer_t
+    , counting_stats_t<true>
+>;
+
+//!< Explicitly instantiate instrumented heap templates to ensure all of it compiles.
+template class heap_t<int, std::vector<int>, stats_heapify_t>;
+template class heap_t<int, std::vector<int>, checked_heapify_t>;
+template class heap_t<
+    int
+    , std::vector<int>
+    , max_heapify_t<typename std::vector<int>::iterator, 2, top_down_sift_t, flat_layout_t<2>, counting_stats_t<>>
+>;
+template struct heap_sort_t<typename std::vector<int>::iterator, stats_heapify_t>;
+
+static_assert(sizeof(max_heap_t<int>) == sizeof(std::vector<int>), "Disabled stats must not cost any space");
+
+TEST_CASE("heap_stats")
+{
+    cout << "((( heap_stats )))" << std::endl;
+    auto heap = heap_t<int, std::vector<int>, stats_heapify_t>{};
+    stats_cmp_op_t::calls = 0;
+    for (int value = 0; 1000 > value; ++value)
+    {
+        heap.push((value * 7919) % 1000);
+    }
+    while (!heap.empty())
+    {
+        heap.pop();
+    }
+
+    // Every comparator call is counted (this comparator is not SIMD eligible.)
+    auto const& stats = heap.stats();
+    cout << "Comparisons: " << stats.comparisons << ", moves: " << stats.moves << ", sifts: " << stats.sifts
+         << ", levels: " << stats.levels << '\n';
+    CHECK(stats_cmp_op_t::calls == stats.comparisons);
+    CHECK(1999 == stats.sifts); // 1000 pushes and 999 pops (popping the last item does not sift.)
+    std::size_t histogram_sifts = 0;
+    std::size_t histogram_levels = 0;
+    for (std::size_t depth = 0; stats.sift_depths.size() > depth; ++depth)
+    {
+        histogram_sifts += stats.sift_depths[depth];
+        histogram_levels += depth * stats.sift_depths[depth];
+    }
+    CHECK(stats.sifts == histogram_sifts);
+    CHECK(stats.levels == histogram_levels);
+    CHECK(stats.moves >= stats.levels);
+    CHECK(0 == stats.sift_depths[heap_stats_t::max_sift_depth]);
+
+    heap.reset_stats();
+    CHECK(0 == heap.stats().comparisons);
+
+    // heap_sort_t counts into the counters it is given.
+    auto values = std::vector<int>(1000);
+    for (std::size_t idx = 0; values.size() > idx; ++idx)
+    {
+        values[idx] = static_cast<int>((idx * 7919) % values.size());
+    }
+    auto counters = heap_stats_t{};
+    stats_cmp_op_t::calls = 0;
+    heap_sort_t<typename std::vector<int>::iterator, stats_heapify_t>{counting_stats_t<>{&counters}}(
+        values.begin()
+        , values.end()
+    );
+    CHECK(std::is_sorted(values.begin(), values.end()));
+    CHECK(stats_cmp_op_t::calls == counters.comparisons);
+    CHECK(0 < counters.moves);
+
+    // So does its partial sort (including the comparisons that reject items.)
+    for (std::size_t idx = 0; values.size() > idx; ++idx)
+    {
+        values[idx] = static_cast<int>((idx * 7919) % values.size());
+    }
+    counters = heap_stats_t{};
+    stats_cmp_op_t::calls = 0;
+    heap_sort_t<typename std::vector<int>::iterator, stats_heapify_t>{counting_stats_t<>{&counters}}(
+        values.begin()
+        , values.begin() + 10
+        , values.end()
+    );
+    CHECK(std::is_sorted(values.begin(), values.begin() + 10));
+    CHECK(9 == values[9]);
+    CHECK(stats_cmp_op_t::calls == counters.comparisons);
+
+    // And insert() counts the comparison that decides which way the new value sifts.
+    heap.push_range(values.begin(), values.end());
+    heap.reset_stats();
+    stats_cmp_op_t::calls = 0;
+    for (int value = 0; 100 > value; ++value)
+    {
+        auto const position = std::find(heap.begin(), heap.end(), (value * 7919) % 1000);
+        heap.insert(position, (value * 7919) % 1000 + (0 == value % 2 ? 1000 : -1000));
+    }
+    CHECK(stats_cmp_op_t::calls == heap.stats().comparisons);
+}
+
+TEST_CASE("heap_invariant")
+{
+    cout << "((( heap_invariant )))" << std::endl;
+    int values[] = { 9, 8, 6, 7, 4, 5, 2, 0, 3, 1 };
+    auto const find_violation = [&]{
+        return find_heap_violation<flat_layout_t<2>, std::greater<int>>(std::begin(values), std::end(values));
+    };
+    CHECK(std::end(values) == find_violation());
+    values[8] = 10;
+    CHECK(&values[8] == find_violation());
+
+    // Checked after every operation (in debug builds.)
+    auto heap = heap_t<int, std::vector<int>, checked_heapify_t>{min_heap_init_val};
+    heap.insert(heap.begin() + 3, 42).push(7).push_range(std::begin(max_heap_init_val), std::end(max_heap_init_val));
+    std::vector<int> popped;
+    heap.pop_n(5, std::back_inserter(popped));
+    CHECK(42 == popped.front());
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+TEST_CASE("heap_replace_top")
+{
+    cout << "((( heap_replace_top )))" << std::endl;
+    auto heap = max_heap_t<int>{max_heap_init_val};
+    CHECK(9 == heap.replace_top(-1));
+    CHECK(10 == heap.size());
+    CHECK(8 == heap.top());
+    CHECK(8 == heap.replace_top(20));
+    CHECK(20 == heap.top());
+
+    int const expected_values[] = { 20, 7, 6, 5, 4, 3, 2, 1, 0, -1 };
+    for (auto const expected_value : expected_values)
+    {
+        CHECK(heap.pop_value() == expected_value);
+    }
+    CHECK_THROWS_AS(heap.replace_top(0), std::out_of_range);
+}
+
+TEST_CASE("heap_push_pop")
+{
+    cout << "((( heap_push_pop )))" << std::endl;
+    auto empty_heap = min_heap_t<int>{};
+    CHECK(5 == empty_heap.push_pop(5));
+    CHECK(empty_heap.empty());
+
+    // Keep the 10 largest of 1000 values in a min heap (sliding top-k.)
+    auto top_k = min_heap_t<int>{min_heap_init_val};
+    for (int idx = 0; 1000 > idx; ++idx)
+    {
+        auto const rejected = top_k.push_pop((idx * 7919) % 1000);
+        CHECK(rejected <= top_k.top());
+    }
+    CHECK(10 == top_k.size());
+    for (int expected_value = 990; !top_k.empty(); ++expected_value)
+    {
+        CHECK(top_k.pop_value() == expected_value);
+    }
+
+    // A value that would be the new head is returned without touching the heap; otherwise it is one sift.
+    using heap_type = min_heap_t<int, 2, top_down_sift_t, flat_layout_t<2>, counting_stats_t<>>;
+    auto heap = heap_type{min_heap_init_val};
+    heap.reset_stats();
+    CHECK(-1 == heap.push_pop(-1));
+    CHECK(0 == heap.stats().sifts);
+    CHECK(1 == heap.stats().comparisons);
+    CHECK(0 == heap.push_pop(100));
+    CHECK(1 == heap.stats().sifts);
+    CHECK(10 == heap.size());
+    CHECK(1 == heap.top());
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+TEST_CASE("parallel_heap_sort")
+{
+    cout << "((( parallel_heap_sort )))" << std::endl;
+    std::vector<int> values(100003);
+    for (std::size_t idx = 0; values.size() > idx; ++idx)
+    {
+        values[idx] = static_cast<int>((idx * 7919) % 1000); // With duplicates.
+    }
+    auto expected_values = values;
+    std::sort(expected_values.begin(), expected_values.end());
+
+    // Tournament merge (unbounded buffer), bounded buffer and in place pairwise merges, 5 (an odd number of) runs.
+    for (auto const max_buffer_items : { std::numeric_limits<std::size_t>::max(), std::size_t{1000}, std::size_t{0} })
+    {
+        auto sorted = values;
+        heap_sort_ascending(sorted.begin(), sorted.end(), parallel_policy_t{5, 1000, max_buffer_items});
+        CHECK(expected_values == sorted);
+    }
+
+    auto sorted = values;
+    heap_sort_decending<std::vector<int>::iterator, 4, bottom_up_sift_t>(
+        sorted.begin(), sorted.end(), parallel_policy_t{3, 1000, 0});
+    CHECK(std::equal(expected_values.rbegin(), expected_values.rend(), sorted.begin(), sorted.end()));
+
+    // Move-only items; too few items per thread are sorted serially.
+    std::vector<std::unique_ptr<int>> pointers;
+    for (int value = 0; 1000 > value; ++value)
+    {
+        pointers.emplace_back(std::make_unique<int>((value * 7919) % 1000));
+    }
+    heap_sort_t<unique_ptr_iter_t, unique_ptr_heapify_t>{}(
+        pointers.begin(), pointers.end(), parallel_policy_t{4, 100, 100});
+    for (std::size_t idx = 0; pointers.size() > idx; ++idx)
+    {
+        CHECK(static_cast<int>(idx) == *pointers[idx]);
+    }
+
+    auto few = std::vector<int>{3, 1, 2};
+    heap_sort_ascending(few.begin(), few.end(), parallel_policy_t{4, 1});
+    CHECK(std::is_sorted(few.begin(), few.end()));
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!< Explicitly instantiate kway_merge_t to ensure all of it compiles.
+template class kway_merge_t<range_source_t<std::vector<int>::const_iterator>>;
+template class kway_merge_t<range_source_t<std::string*>, std::greater<std::string>, 4>;
+
+//!\brief Generator of the sorted sequence first, first + step, ... (count items), for generator_source_t.
+struct arithmetic_generator_t
+{
+    int next;
+    int step;
+    std::size_t count;
+    std::size_t* calls;
+
+    std::size_t operator()(int* out, std::size_t const max_count)
+    {
+        ++*calls;
+        auto const written = std::min(count, max_count);
+        for (std::size_t idx = 0; written > idx; ++idx, next += step)
+        {
+            out[idx] = next;
+        }
+        count -= written;
+        return written;
+    }
+};
+
+TEST_CASE("kway_merge")
+{
+    cout << "((( kway_merge )))" << std::endl;
+    using source_type = range_source_t<std::vector<int>::const_iterator>;
+    auto const runs = std::vector<std::vector<int>>{{1, 4, 7, 10}, {}, {2, 2, 5}, {0, 3, 6, 9, 12, 15}, {8}};
+    std::vector<source_type> sources;
+    std::vector<int> expected_values;
+    for (auto const& run : runs)
+    {
+        sources.emplace_back(run.begin(), run.end());
+        expected_values.insert(expected_values.end(), run.begin(), run.end());
+    }
+    std::sort(expected_values.begin(), expected_values.end());
+
+    auto merge = kway_merge_t<source_type>{std::move(sources)};
+    CHECK(4 == merge.active_sources());
+    CHECK(0 == merge.top());
+    CHECK(expected_values == std::vector<int>(merge.begin(), merge.end()));
+    CHECK(merge.empty());
+    CHECK_THROWS_AS(merge.pop(), std::out_of_range);
+    CHECK(kway_merge_t<source_type>{}.begin() == kway_merge_t<source_type>{}.end());
+
+    // Ties are taken from the lower source first (the merge is stable.)
+    using tagged_type = std::pair<int, int>;
+    struct first_less_t
+    {
+        bool operator()(tagged_type const& lhs, tagged_type const& rhs) const { return lhs.first < rhs.first; }
+    };
+    auto const tagged_runs = std::vector<std::vector<tagged_type>>{
+        {{1, 0}, {3, 0}}, {{1, 1}, {2, 1}}, {{1, 2}, {3, 2}}};
+    std::vector<range_source_t<std::vector<tagged_type>::const_iterator>> tagged_sources;
+    for (auto const& run : tagged_runs)
+    {
+        tagged_sources.emplace_back(run.begin(), run.end());
+    }
+    auto expected_tagged = std::vector<tagged_type>{{1, 0}, {1, 1}, {1, 2}, {2, 1}, {3, 0}, {3, 2}};
+    auto tagged = kway_merge_t<range_source_t<std::vector<tagged_type>::const_iterator>, first_less_t, 4>{
+        std::move(tagged_sources)};
+    CHECK(expected_tagged == std::vector<tagged_type>(tagged.begin(), tagged.end()));
+
+    // Generators are refilled a chunk (of 8 items) at a time, and pulled from in batches.
+    std::size_t calls = 0;
+    using generator_source_type = generator_source_t<int, arithmetic_generator_t>;
+    std::vector<generator_source_type> generators;
+    for (int idx = 0; 3 > idx; ++idx)
+    {
+        generators.emplace_back(arithmetic_generator_t{idx, 3, 100, &calls}, 8);
+    }
+    auto generated = kway_merge_t<generator_source_type>{std::move(generators)};
+    std::vector<int> pulled(300);
+    CHECK(128 == generated.pull(pulled.begin(), 128));
+    CHECK(3 * 6 >= calls); // About 43 items, or 6 chunks, per source.
+    CHECK(172 == generated.pull(pulled.begin() + 128, 1000));
+    CHECK(0 == generated.pull(pulled.begin(), 1));
+    CHECK(3 * 14 == calls); // 13 chunks per source, and the empty one.
+    for (std::size_t idx = 0; pulled.size() > idx; ++idx)
+    {
+        CHECK(static_cast<int>(idx) == pulled[idx]);
+    }
+
+    // Move-only items are moved out of their sources (here in descending order.)
+    std::vector<std::unique_ptr<int>> pointers[2];
+    for (int value = 9; 0 <= value; --value)
+    {
+        pointers[value % 2].emplace_back(std::make_unique<int>(value));
+    }
+    std::vector<range_source_t<std::vector<std::unique_ptr<int>>::iterator>> pointer_sources;
+    for (auto& run : pointers)
+    {
+        pointer_sources.emplace_back(run.begin(), run.end());
+    }
+    auto pointer_merge = kway_merge_t<range_source_t<std::vector<std::unique_ptr<int>>::iterator>, pointee_greater_t>{
+        std::move(pointer_sources)};
+    for (int expected_value = 9; 0 <= expected_value; --expected_value)
+    {
+        CHECK(expected_value == *pointer_merge.pop_value());
+    }
+    CHECK(nullptr == pointers[0][0]);
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+#if defined(__unix__) || defined(__APPLE__)
+
+//!< Explicitly instantiate mmap_vector_t and mmap_max_heap_t to ensure all of it compiles.
+template class mmap_vector_t<int>;
+template class heap_t<int, mmap_vector_t<int>, max_heapify_t<int*, 4, bottom_up_sift_t, page_blocked_layout_t<int, 4>>>;
+
+TEST_CASE("mmap_heap")
+{
+    cout << "((( mmap_heap )))" << std::endl;
+    auto items = mmap_vector_t<int>{};
+    CHECK(items.empty());
+    CHECK(0 == items.capacity());
+    for (int value = 0; 100000 > value; ++value)
+    {
+        items.push_back(value); // Grows (and remaps) across many pages.
+    }
+    CHECK(100000 == items.size());
+    CHECK(items.capacity() >= items.size());
+    auto const inserted = std::vector<int>{-3, -2, -1};
+    items.insert(items.begin(), inserted.begin(), inserted.end());
+    items.erase(items.begin() + 3, items.begin() + 99003);
+    CHECK(std::vector<int>{-3, -2, -1, 99000} == std::vector<int>(items.begin(), items.begin() + 4));
+    CHECK(1003 == items.size());
+    auto copy = items;
+    items.shrink_to_fit();
+    CHECK(items.capacity() < 100000);
+    CHECK(std::equal(copy.begin(), copy.end(), items.begin(), items.end()));
+
+    // Heap items page to the file; the top block stays locked in RAM (if permitted.)
+    auto heap = mmap_max_heap_t<int, 4>{mmap_storage_t{"", 4096}};
+    CHECK("" == heap.get_allocator().directory);
+    for (std::size_t idx = 0; 100003 > idx; ++idx)
+    {
+        heap.push(static_cast<int>((idx * 7919) % 100003));
+    }
+    for (int expected_value = 100002; 100000 <= expected_value; --expected_value)
+    {
+        CHECK(heap.pop_value() == expected_value);
+    }
+    std::vector<int> popped;
+    while (!heap.empty())
+    {
+        popped.emplace_back(heap.pop_value());
+    }
+    CHECK(100000 == popped.size());
+    CHECK(std::is_sorted(popped.rbegin(), popped.rend()));
+
+    auto min_heap = mmap_min_heap_t<int>{min_heap_init_val};
+    CHECK(0 == min_heap.pop_value());
+    CHECK(1 == min_heap.top());
+
+    auto unwritable = mmap_vector_t<int>{mmap_storage_t{"/nonexistent-directory"}};
+    CHECK_THROWS_AS(unwritable.push_back(1), std::system_error);
+}
+
+#endif // #if defined(__unix__) || defined(__APPLE__)
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!\brief Stream buffer that cannot seek (like a pipe's), to read snapshots from.
+class unseekable_buffer_t : public std::stringbuf
+{
+public:
+    using std::stringbuf::stringbuf;
+
+protected:
+    pos_type seekoff(off_type, std::ios_base::seekdir, std::ios_base::openmode) override { return pos_type(-1); }
+    pos_type seekpos(pos_type, std::ios_base::openmode) override { return pos_type(-1); }
+};
+
+#if defined(__unix__) || defined(__APPLE__)
+//!\brief A uniquely named file in $TMPDIR (else /tmp), removed (also when a check throws) with this object.
+class temp_file_t
+{
+public:
+    temp_file_t()
+    {
+        auto const* const tmpdir = std::getenv("TMPDIR");
+        path = std::string{nullptr != tmpdir && '\0' != *tmpdir ? tmpdir : "/tmp"} + "/heap_test_XXXXXX";
+        auto const fd = ::mkstemp(path.data());
+        REQUIRE(0 <= fd);
+        ::close(fd);
+    }
+    temp_file_t(temp_file_t const&) = delete;
+    temp_file_t& operator=(temp_file_t const&) = delete;
+    ~temp_file_t() { std::remove(path.c_str()); }
+
+    std::string path;
+};
+#endif // #if defined(__unix__) || defined(__APPLE__)
+
+TEST_CASE("heap_snapshot")
+{
+    cout << "((( heap_snapshot )))" << std::endl;
+    std::vector<int> values(1000);
+    for (std::size_t idx = 0; values.size() > idx; ++idx)
+    {
+        values[idx] = static_cast<int>((idx * 7919) % 1000);
+    }
+    auto const heap = max_heap_t<int, 4>{values.begin(), values.end()};
+    auto snapshot = std::stringstream{};
+    save_heap_snapshot(heap, snapshot);
+    CHECK(sizeof(heap_snapshot_header_t) + values.size() * sizeof(int) == snapshot.str().size());
+
+    // The array is adopted as saved, not heapified again.
+    auto loaded = load_heap_snapshot<max_heap_t<int, 4>>(snapshot);
+    CHECK(std::equal(heap.begin(), heap.end(), loaded.begin(), loaded.end()));
+    for (int expected_value = 999; 990 <= expected_value; --expected_value)
+    {
+        CHECK(loaded.pop_value() == expected_value);
+    }
+
+    // The header must match the heap type.
+    auto const bytes = snapshot.str();
+    auto in = std::stringstream{bytes};
+    CHECK_THROWS_AS(static_cast<void>(load_heap_snapshot<min_heap_t<int, 4>>(in)), std::runtime_error);
+    in = std::stringstream{bytes};
+    CHECK_THROWS_AS(static_cast<void>(load_heap_snapshot<max_heap_t<int>>(in)), std::runtime_error);
+    in = std::stringstream{bytes};
+    CHECK_THROWS_AS(static_cast<void>(load_heap_snapshot<max_heap_t<std::int64_t, 4>>(in)), std::runtime_error);
+    in = std::stringstream{bytes.substr(0, bytes.size() - 1)};
+    CHECK_THROWS_AS(static_cast<void>(load_heap_snapshot<max_heap_t<int, 4>>(in)), std::runtime_error);
+
+    // A count beyond the end of the stream (or of memory) is rejected before anything is allocated for it; and
+    // from a stream that cannot tell its size, only as much is allocated as is read (in bounded chunks.)
+    for (auto const count : {std::uint64_t{1} << 40, std::numeric_limits<std::uint64_t>::max()})
+    {
+        auto header = heap_snapshot_header_t{};
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        header.count = count;
+        auto hostile = bytes;
+        std::memcpy(hostile.data(), &header, sizeof(header));
+        in = std::stringstream{hostile};
+        CHECK_THROWS_AS(static_cast<void>(load_heap_snapshot<max_heap_t<int, 4>>(in)), std::runtime_error);
+        auto unseekable_buffer = unseekable_buffer_t{hostile};
+        auto unseekable = std::istream{&unseekable_buffer};
+        CHECK_THROWS_AS(static_cast<void>(load_heap_snapshot<max_heap_t<int, 4>>(unseekable)), std::runtime_error);
+    }
+    auto unseekable_buffer = unseekable_buffer_t{bytes};
+    auto unseekable = std::istream{&unseekable_buffer};
+    CHECK(999 == load_heap_snapshot<max_heap_t<int, 4>>(unseekable).top());
+
+    // A corrupted item fails the checksum, unless verification is skipped.
+    auto corrupted = bytes;
+    corrupted[sizeof(heap_snapshot_header_t)] ^= 1;
+    in = std::stringstream{corrupted};
+    CHECK_THROWS_AS(static_cast<void>(load_heap_snapshot<max_heap_t<int, 4>>(in)), std::runtime_error);
+    in = std::stringstream{corrupted};
+    CHECK(999 != load_heap_snapshot<max_heap_t<int, 4>>(in, false).top());
+
+    // An array that is not in heap order fails the invariant check.
+    auto const unordered = max_heap_t<int>{heap_ordered, std::vector<int>{1, 2, 3}};
+    auto unordered_snapshot = std::stringstream{};
+    save_heap_snapshot(unordered, unordered_snapshot);
+    CHECK_THROWS_AS(static_cast<void>(load_heap_snapshot<max_heap_t<int>>(unordered_snapshot)), std::runtime_error);
+
+    // Into another allocator.
+    auto arena = std::pmr::monotonic_buffer_resource{};
+    in = std::stringstream{bytes};
+    auto const arena_heap = load_heap_snapshot<pmr_max_heap_t<int, 4>>(in, true, &arena);
+    CHECK(arena_heap.get_allocator().resource() == &arena);
+    CHECK(999 == arena_heap.top());
+
+#if defined(__unix__) || defined(__APPLE__)
+    // Mapped: pages are read on demand and changes are private, also after the heap outgrows the file.
+    auto const file = temp_file_t{};
+    auto const& path = file.path;
+    auto const file_heap = mmap_max_heap_t<int, 4>{values.begin(), values.end()};
+    save_heap_snapshot(file_heap, path);
+    auto mapped = map_heap_snapshot<mmap_max_heap_t<int, 4>>(path);
+    CHECK(std::equal(file_heap.begin(), file_heap.end(), mapped.begin(), mapped.end()));
+    CHECK(999 == mapped.pop_value());
+    for (int value = 1000; 3000 > value; ++value)
+    {
+        mapped.push(value);
+    }
+    CHECK(2999 == mapped.top());
+    CHECK(2999 == mapped.size());
+    auto remapped = map_heap_snapshot<mmap_max_heap_t<int, 4>>(path);
+    CHECK(1000 == remapped.size());
+    CHECK(999 == remapped.top());
+    CHECK(999 == load_heap_snapshot<max_heap_t<int, 4, top_down_sift_t, page_blocked_layout_t<int, 4>>>(path).top());
+    CHECK_THROWS_AS(static_cast<void>(map_heap_snapshot<mmap_min_heap_t<int, 4>>(path)), std::runtime_error);
+    CHECK(0 == ::truncate(path.c_str(), static_cast<off_t>(sizeof(heap_snapshot_header_t) + 999 * sizeof(int))));
+    CHECK_THROWS_AS(static_cast<void>(map_heap_snapshot<mmap_max_heap_t<int, 4>>(path)), std::runtime_error);
+#endif // #if defined(__unix__) || defined(__APPLE__)
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!< Explicitly instantiate min_max_heap_t to ensure all of it compiles.
+template class min_max_heap_t<int>;
+template class min_max_heap_t<std::string, std::pmr::vector<std::string>, std::greater<std::string>>;
+
+TEST_CASE("min_max_heap")
+{
+    cout << "((( min_max_heap )))" << std::endl;
+    auto heap = min_max_heap_t<int>{max_heap_init_val};
+    CHECK(10 == heap.size());
+    CHECK(0 == heap.min());
+    CHECK(9 == heap.max());
+    CHECK(9 == heap.pop_max_value());
+    CHECK(0 == heap.pop_min_value());
+    CHECK(1 == heap.min());
+    CHECK(8 == heap.max());
+
+    // Interleaved pushes and pops from both ends, against a sorted reference.
+    auto mixed = min_max_heap_t<int>{};
+    std::vector<int> expected_values;
+    for (int idx = 0; 2000 > idx; ++idx)
+    {
+        auto const value = (idx * 7919) % 1009;
+        mixed.push(value);
+        expected_values.insert(std::upper_bound(expected_values.begin(), expected_values.end(), value), value);
+        if (0 == idx % 3)
+        {
+            CHECK(mixed.pop_min_value() == expected_values.front());
+            expected_values.erase(expected_values.begin());
+        }
+        else if (1 == idx % 5)
+        {
+            CHECK(mixed.pop_max_value() == expected_values.back());
+            expected_values.pop_back();
+        }
+        if (!expected_values.empty())
+        {
+            CHECK(mixed.min() == expected_values.front());
+            CHECK(mixed.max() == expected_values.back());
+        }
+    }
+    CHECK(expected_values.size() == mixed.size());
+    while (!mixed.empty())
+    {
+        CHECK(mixed.pop_max_value() == expected_values.back());
+        expected_values.pop_back();
+        if (!mixed.empty())
+        {
+            CHECK(mixed.pop_min_value() == expected_values.front());
+            expected_values.erase(expected_values.begin());
+        }
+    }
+    CHECK_THROWS_AS(mixed.pop_min(), std::out_of_range);
+    CHECK_THROWS_AS(static_cast<void>(mixed.max()), std::out_of_range);
+
+    // Built from a range (bottom up), with storage from an arena and a reversed comparator.
+    std::vector<std::string> words;
+    for (int idx = 0; 500 > idx; ++idx)
+    {
+        words.emplace_back(std::to_string((idx * 7919) % 500));
+    }
+    auto arena = std::pmr::monotonic_buffer_resource{};
+    auto const allocator = std::pmr::polymorphic_allocator<std::string>{&arena};
+    auto word_heap = pmr_min_max_heap_t<std::string, std::greater<std::string>>{words.begin(), words.end(), allocator};
+    CHECK(word_heap.get_allocator().resource() == &arena);
+    std::sort(words.begin(), words.end());
+    CHECK(words.back() == word_heap.min());
+    CHECK(words.front() == word_heap.max());
+    for (auto const& word : words)
+    {
+        CHECK(word == word_heap.pop_max_value());
+    }
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!\brief A timer that can be cancelled (marked dead) while in a tombstone_heap_t.
+struct cancellable_timer_t
+{
+    int deadline;
+    std::shared_ptr<bool> cancelled;
+};
+
+struct earlier_deadline_t
+{
+    bool operator()(cancellable_timer_t const& lhs, cancellable_timer_t const& rhs) const
+    {
+        return lhs.deadline < rhs.deadline;
+    }
+};
+
+struct is_cancelled_t
+{
+    bool operator()(cancellable_timer_t const& timer) const { return *timer.cancelled; }
+};
+
+using timer_heap_t = heap_t<
+    cancellable_timer_t
+    , std::vector<cancellable_timer_t>
+    , heapify_t<std::vector<cancellable_timer_t>::iterator, earlier_deadline_t>
+>;
+
+//!< Explicitly instantiate tombstone_heap_t to ensure all of it compiles.
+template class tombstone_heap_t<cancellable_timer_t, is_cancelled_t, timer_heap_t>;
+
+TEST_CASE("heap_erase")
+{
+    cout << "((( heap_erase )))" << std::endl;
+    std::vector<int> values(1000);
+    for (std::size_t idx = 0; values.size() > idx; ++idx)
+    {
+        values[idx] = static_cast<int>((idx * 7919) % 1000);
+    }
+
+    // Erase arbitrary elements, each moving the last element up or down (also in a blocked 4-ary heap.)
+    auto heap = max_heap_t<int>{values.begin(), values.end()};
+    auto blocked_heap = max_heap_t<int, 4, top_down_sift_t, blocked_layout_t<4, 2>>{values.begin(), values.end()};
+    for (int value = 0; 1000 > value; value += 3)
+    {
+        heap.erase(std::find(heap.begin(), heap.end(), value));
+        blocked_heap.erase(std::find(blocked_heap.begin(), blocked_heap.end(), value));
+        CHECK(heap.end() == (find_heap_violation<flat_layout_t<2>, std::greater<int>>(heap.begin(), heap.end())));
+        CHECK(blocked_heap.end() == (find_heap_violation<blocked_layout_t<4, 2>, std::greater<int>>(
+            blocked_heap.begin(), blocked_heap.end())));
+    }
+    heap.erase(heap.begin());
+    CHECK(665 == heap.size());
+    CHECK(997 == heap.top());
+
+    // Every comparison of an erase is counted, including the one that picks the direction of its sift.
+    auto counted_heap = heap_t<int, std::vector<int>, stats_heapify_t>{values.begin(), values.end()};
+    counted_heap.reset_stats();
+    stats_cmp_op_t::calls = 0;
+    for (int value = 0; 1000 > value; value += 7)
+    {
+        counted_heap.erase(std::find(counted_heap.begin(), counted_heap.end(), value));
+    }
+    CHECK(stats_cmp_op_t::calls == counted_heap.stats().comparisons);
+
+    // Erase all odd elements at once.
+    CHECK(333 == blocked_heap.erase_if([](int const value){ return 0 != value % 2; }));
+    CHECK(0 == blocked_heap.erase_if([](int const value){ return 0 > value; }));
+    for (int expected_value = 998; 0 < expected_value; expected_value -= 2)
+    {
+        if (0 != expected_value % 3)
+        {
+            CHECK(blocked_heap.pop_value() == expected_value);
+        }
+    }
+    CHECK(blocked_heap.empty());
+
+    // Tombstones: cancelled timers are skipped at the top, and compacted once a quarter of them are cancelled.
+    auto timers = tombstone_heap_t<cancellable_timer_t, is_cancelled_t, timer_heap_t>{};
+    std::vector<std::shared_ptr<bool>> cancelled;
+    for (int deadline = 0; 100 > deadline; ++deadline)
+    {
+        cancelled.emplace_back(std::make_shared<bool>(false));
+        timers.push(cancellable_timer_t{deadline, cancelled.back()});
+    }
+    for (int deadline = 0; 10 > deadline; ++deadline)
+    {
+        *cancelled[static_cast<std::size_t>(deadline)] = true;
+        timers.note_dead();
+    }
+    CHECK(90 == timers.size());
+    CHECK(100 == timers.heap().size());
+    CHECK(10 == timers.top().deadline); // Drops the 10 dead timers above it.
+    CHECK(0 == timers.dead_count());
+    CHECK(90 == timers.heap().size());
+    for (std::size_t deadline = 20; 42 > deadline; ++deadline)
+    {
+        *cancelled[deadline] = true;
+        timers.note_dead();
+    }
+    CHECK(22 == timers.dead_count());
+    *cancelled[42] = true;
+    timers.note_dead(); // 23 of 90 dead: compacted.
+    CHECK(0 == timers.dead_count());
+    CHECK(67 == timers.heap().size());
+    for (int expected_deadline : {10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 43})
+    {
+        CHECK(expected_deadline == timers.pop_value().deadline);
+    }
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!< Explicitly instantiate heap_t with prefetching to ensure all of it compiles.
+template class heap_t<
+    int
+    , std::vector<int>
+    , max_heapify_t<std::vector<int>::iterator, 2, prefetch_sift_t<>>
+>;
+template class heap_t<
+    std::string
+    , std::vector<std::string>
+    , min_heapify_t<std::vector<std::string>::iterator, 4, prefetch_sift_t<bottom_up_sift_t, 0>, blocked_layout_t<4, 2>>
+>;
+
+//!\brief Pop all of a heap built from 'values'; return the popped values and the heap's stats.
+template <typename t_heap_t>
+std::pair<std::vector<int>, heap_stats_t> drain_with_stats(std::vector<int> const& values)
+{
+    auto heap = t_heap_t{values.begin(), values.end()};
+    heap.reset_stats();
+    std::vector<int> popped;
+    while (!heap.empty())
+    {
+        popped.emplace_back(heap.pop_value());
+    }
+    return {popped, heap.stats()};
+}
+
+TEST_CASE("prefetch_sift")
+{
+    cout << "((( prefetch_sift )))" << std::endl;
+    std::vector<int> values(20011);
+    for (std::size_t idx = 0; values.size() > idx; ++idx)
+    {
+        values[idx] = static_cast<int>((idx * 7919) % values.size());
+    }
+
+    // Prefetching (here at any size) changes neither the order nor the work of a sift (of any arity or policy.)
+    using stats_type = counting_stats_t<>;
+    using prefetch_type = prefetch_sift_t<top_down_sift_t, 0>;
+    using bottom_up_prefetch_type = prefetch_sift_t<bottom_up_sift_t, 0>;
+    auto const check_same = [](auto const& lhs, auto const& rhs){
+        CHECK(lhs.first == rhs.first);
+        CHECK(lhs.second.comparisons == rhs.second.comparisons);
+        CHECK(lhs.second.moves == rhs.second.moves);
+    };
+    check_same(
+        drain_with_stats<max_heap_t<int, 2, top_down_sift_t, flat_layout_t<2>, stats_type>>(values)
+        , drain_with_stats<max_heap_t<int, 2, prefetch_type, flat_layout_t<2>, stats_type>>(values));
+    check_same(
+        drain_with_stats<max_heap_t<int, 4, bottom_up_sift_t, flat_layout_t<4>, stats_type>>(values)
+        , drain_with_stats<max_heap_t<int, 4, bottom_up_prefetch_type, flat_layout_t<4>, stats_type>>(values));
+    check_same(
+        drain_with_stats<max_heap_t<int, 8, top_down_sift_t, flat_layout_t<8>, stats_type>>(values)
+        , drain_with_stats<max_heap_t<int, 8, prefetch_type, flat_layout_t<8>, stats_type>>(values));
+    check_same(
+        drain_with_stats<max_heap_t<int, 2, top_down_sift_t, blocked_layout_t<2, 3>, stats_type>>(values)
+        , drain_with_stats<max_heap_t<int, 2, prefetch_type, blocked_layout_t<2, 3>, stats_type>>(values));
+
+    auto const sorted = drain_with_stats<min_heap_t<int, 2, prefetch_sift_t<>, flat_layout_t<2>, stats_type>>(values);
+    CHECK(std::is_sorted(sorted.first.begin(), sorted.first.end()));
+    CHECK(values.size() == sorted.first.size());
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!< Explicitly instantiate heap_t with each sift policy to ensure all of it compiles.
+template class heap_t<
+    int
+    , std::vector<int>
+    , max_heapify_t<std::vector<int>::iterator, 2, recursive_sift_up_t<>, precise_flat_layout_t<2>>
+>;
+template class heap_t<
+    std::string
+    , std::vector<std::string>
+    , min_heapify_t<std::vector<std::string>::iterator, 4, branchless_sift_t<bottom_up_sift_t>>
+>;
+
+TEST_CASE("sift_policies")
+{
+    cout << "((( sift_policies )))" << std::endl;
+    std::vector<int> values(20011);
+    for (std::size_t idx = 0; values.size() > idx; ++idx)
+    {
+        values[idx] = static_cast<int>((idx * 7919) % values.size());
+    }
+
+    // Each policy (or combination of them) pops in the same order, and with the same comparisons, as the default.
+    using stats_type = counting_stats_t<>;
+    auto const check_same = [](auto const& lhs, auto const& rhs){
+        CHECK(lhs.first == rhs.first);
+        CHECK(lhs.second.comparisons == rhs.second.comparisons);
+    };
+    auto const expected_2 = drain_with_stats<max_heap_t<int, 2, top_down_sift_t, flat_layout_t<2>, stats_type>>(values);
+    check_same(
+        expected_2
+        , drain_with_stats<max_heap_t<int, 2, recursive_sift_up_t<>, flat_layout_t<2>, stats_type>>(values));
+    check_same(
+        expected_2
+        , drain_with_stats<max_heap_t<int, 2, top_down_sift_t, precise_flat_layout_t<2>, stats_type>>(values));
+    check_same(
+        expected_2
+        , drain_with_stats<max_heap_t<int, 2, branchless_sift_t<>, flat_layout_t<2>, stats_type>>(values));
+    check_same(
+        drain_with_stats<max_heap_t<int, 4, bottom_up_sift_t, flat_layout_t<4>, stats_type>>(values)
+        , drain_with_stats<max_heap_t<int, 4, branchless_sift_t<bottom_up_sift_t>, flat_layout_t<4>, stats_type>>(
+            values));
+    check_same(
+        drain_with_stats<max_heap_t<int, 8, top_down_sift_t, precise_flat_layout_t<8>, stats_type>>(values)
+        , drain_with_stats<max_heap_t<int, 8, branchless_sift_t<>, flat_layout_t<8>, stats_type>>(values));
+    check_same(
+        drain_with_stats<max_heap_t<int, 2, bottom_up_sift_t, flat_layout_t<2>, stats_type>>(values)
+        , drain_with_stats<
+            max_heap_t<int, 2, prefetch_sift_t<branchless_sift_t<bottom_up_sift_t>, 0>, flat_layout_t<2>, stats_type>
+        >(values));
+
+    // The policies of a wrapped policy show through the wrapper.
+    using composed_type = prefetch_sift_t<branchless_sift_t<recursive_sift_up_t<>>, 0>;
+    CHECK(sift_policy_traits<composed_type>::is_prefetching);
+    CHECK(sift_policy_traits<composed_type>::is_branchless);
+    CHECK(sift_policy_traits<composed_type>::is_recursive_up);
+    CHECK(!sift_policy_traits<top_down_sift_t>::is_branchless);
+    CHECK(!sift_policy_traits<bottom_up_sift_t>::is_recursive_up);
+
+    // Recursive heapify up reaches the same heap as the iterative one, one element at a time.
+    auto heap = max_heap_t<int, 2, recursive_sift_up_t<>>{};
+    auto reference = max_heap_t<int>{};
+    for (int value : values)
+    {
+        heap.push(value);
+        reference.push(value);
+    }
+    CHECK(std::equal(heap.begin(), heap.end(), reference.begin(), reference.end()));
+}
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!< Explicitly instantiate timer_queue_t to ensure all of it compiles.
+template class timer_queue_t<std::function<void()>>;
+template class timer_queue_t<std::string, int, 4>;
+
+TEST_CASE("timer_queue")
+{
+    cout << "((( timer_queue )))" << std::endl;
+    auto timers = timer_queue_t<int, int>{};
+    std::vector<int> fired;
+    auto const record = [&fired](int payload){ fired.emplace_back(payload); };
+
+    std::vector<timer_handle_t> handles;
+    for (int idx = 0; 100 > idx; ++idx)
+    {
+        handles.emplace_back(timers.schedule((idx * 37) % 100, idx)); // Deadline 'idx * 37 % 100' fires payload 'idx'.
+    }
+    CHECK(100 == timers.size());
+    CHECK(0 == timers.next_deadline());
+    CHECK(0 == timers.expire_until(-1, record));
+
+    // Cancel the timer due at 1 (payload 73) and move the one due at 2 (payload 46) to 50, after payload 50.
+    CHECK(timers.cancel(handles[73]));
+    CHECK(!timers.cancel(handles[73]));
+    CHECK(!timers.contains(handles[73]));
+    timers.reschedule(handles[46], 50);
+    CHECK(50 == timers.deadline(handles[46]));
+
+    CHECK(2 == timers.expire_until(3, record));
+    CHECK((std::vector<int>{0, 19} == fired));
+    CHECK(!timers.contains(handles[19]));
+    CHECK_THROWS_AS(timers.reschedule(handles[19], 10), std::out_of_range);
+
+    // A stale handle doesn't match a new timer that reuses its slot.
+    auto const reused = timers.schedule(1000, 1000);
+    CHECK(!timers.contains(handles[0]));
+    CHECK(handles[0] != reused);
+    CHECK(!timers.cancel(handles[0]));
+    CHECK(timers.contains(reused));
+
+    // Equal deadlines expire in scheduling order, and what a callback schedules waits for the next batch.
+    fired.clear();
+    auto const reschedule_self = [&](int payload){
+        fired.emplace_back(payload);
+        if (46 == payload) { timers.schedule(0, -46); }
+    };
+    CHECK(48 == timers.expire_until(50, reschedule_self));
+    CHECK(50 == fired[fired.size() - 2]);
+    CHECK(46 == fired.back());
+    CHECK(0 == timers.next_deadline());
+    fired.clear();
+    CHECK(1 + 49 == timers.expire_until(999, record));
+    CHECK(-46 == fired.front());
+    CHECK(1 == timers.size());
+    CHECK(1000 == timers.next_deadline());
+
+    // The usual clock types work, and the queue never reads the clock itself.
+    using clock_type = std::chrono::steady_clock;
+    auto chrono_timers = timer_queue_t<std::function<void()>>{};
+    auto const start = clock_type::time_point{};
+    int ticks = 0;
+    chrono_timers.schedule(start + std::chrono::milliseconds{20}, [&ticks]{ ticks += 20; });
+    chrono_timers.schedule(start + std::chrono::milliseconds{10}, [&ticks]{ ticks += 10; });
+    CHECK(1 == chrono_timers.expire_until(start + std::chrono::milliseconds{15}, [](auto&& f){ f(); }));
+    CHECK(10 == ticks);
+    CHECK(start + std::chrono::milliseconds{20} == chrono_timers.next_deadline());
+}
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+//!\brief Coroutine that starts eagerly and destroys itself when it completes.
+struct detached_task_t
+{
+    struct promise_type
+    {
+        detached_task_t get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+detached_task_t sleeper(coroutine_timer_queue_t<int>& timers, int period, int count, std::vector<int>& woken)
+{
+    for (int idx = 1; count >= idx; ++idx)
+    {
+        co_await sleep_until(timers, idx * period);
+        woken.emplace_back(idx * period);
+    }
+}
+
+TEST_CASE("timer_queue_coroutines")
+{
+    cout << "((( timer_queue_coroutines )))" << std::endl;
+    auto timers = coroutine_timer_queue_t<int>{};
+    std::vector<int> woken;
+    sleeper(timers, 3, 4, woken);
+    sleeper(timers, 5, 2, woken);
+    CHECK(2 == timers.size());
+    CHECK(woken.empty());
+
+    // A single threaded event loop: each pass resumes the coroutines that are due, which then sleep again.
+    for (int now = 0; !timers.empty(); ++now)
+    {
+        resume_until(timers, now);
+    }
+    CHECK((std::vector<int>{3, 5, 6, 9, 10, 12} == woken));
+}
+
+#endif // #if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+// [----------------(120 columns)---------------> Module Code Delimiter <---------------(120 columns)----------------]
+
+//!< Explicitly instantiate the packed key codec and heaps to ensure all of it compiles.
+template struct packed_key_t<float>;
+template struct packed_key_t<std::int16_t>;
+template struct packed_key_t<std::uint32_t>;
+template class heap_t<
+    std::uint64_t
+    , std::vector<std::uint64_t>
+    , max_heapify_t<std::vector<std::uint64_t>::iterator, 4, branchless_sift_t<>>
+>;
+
+static_assert(
+    std::is_same_v<packed_min_heap_t<>, min_heap_t<std::uint64_t, 2, branchless_sift_t<>>>
+    , "Packed heaps select children branchlessly by default");
+
+TEST_CASE("packed_key")
+{
+    cout << "((( packed_key )))" << std::endl;
+
+    // Keys round trip, and compare like their priorities do (payloads breaking ties.)
+    using float_key_type = packed_key_t<float>;
+    std::vector<float> const floats{
+        -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::lowest(), -2.5f, -1.0f
+        , -std::numeric_limits<float>::denorm_min(), -0.0f, 0.0f, std::numeric_limits<float>::denorm_min()
+        , std::numeric_limits<float>::min(), 1.0f, 2.5f, std::numeric_limits<float>::max()
+        , std::numeric_limits<float>::infinity()};
+    for (std::size_t idx = 0; floats.size() > idx; ++idx)
+    {
+        auto const key = float_key_type::encode(floats[idx], static_cast<std::uint32_t>(idx));
+        auto const [priority, payload] = float_key_type::decode(key);
+        CHECK(std::signbit(floats[idx]) == std::signbit(priority));
+        CHECK(floats[idx] == priority);
+        CHECK(idx == payload);
+        if (0 != idx)
+        {
+            CHECK(float_key_type::encode(floats[idx - 1], 0xffffffffu) < float_key_type::encode(floats[idx], 0));
+        }
+    }
+    CHECK(float_key_type::encode(1.0f, 1) < float_key_type::encode(1.0f, 2));
+
+    using int_key_type = packed_key_t<std::int16_t>;
+    auto previous_key = std::uint64_t{0};
+    for (int value : {-32768, -1000, -1, 0, 1, 1000, 32767})
+    {
+        auto const key = int_key_type::encode(static_cast<std::int16_t>(value), 7);
+        CHECK(value == int_key_type::priority(key));
+        CHECK(7 == int_key_type::payload(key));
+        CHECK(previous_key < key);
+        previous_key = key;
+    }
+    CHECK(0xdeadbeefu == packed_key_t<std::uint32_t>::priority(packed_key_t<std::uint32_t>::encode(0xdeadbeefu, 0)));
+
+    // A packed heap pops in the same order as a heap of (priority, index) pairs.
+    std::vector<std::pair<float, std::uint32_t>> items(10007);
+    for (std::size_t idx = 0; items.size() > idx; ++idx)
+    {
+        items[idx] = {static_cast<float>((idx * 7919) % 1009) - 504.5f, static_cast<std::uint32_t>(idx)};
+    }
+    auto pairs = max_heap_t<std::pair<float, std::uint32_t>>{items.begin(), items.end()};
+    auto packed = packed_max_heap_t<4, branchless_sift_t<>>{};
+    auto min_packed = packed_min_heap_t<8>{};
+    for (auto const& item : items)
+    {
+        packed.push(float_key_type::encode(item.first, item.second));
+        min_packed.push(float_key_type::encode(item.first, item.second));
+    }
+    std::vector<std::pair<float, std::uint32_t>> popped;
+    while (!pairs.empty())
+    {
+        auto const expected = pairs.pop_value();
+        CHECK(expected == float_key_type::decode(packed.pop_value()));
+        popped.emplace_back(expected);
+    }
+    CHECK(packed.empty());
+    CHECK(std::equal(popped.rbegin(), popped.rend(), items.begin(), items.end(), [&](auto const& lhs, auto const&){
+        return lhs == float_key_type::decode(min_packed.pop_value());
+    }));
+}
+
 /*
     End of "main.cpp"
 */